@@ -0,0 +1,137 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "BenchmarkTimer.h"
+
+static const wstring projectFileStep=L"Writing: ";
+
+BenchmarkTimer::BenchmarkTimer()
+{
+  _isRunning=false;
+}
+
+void BenchmarkTimer::nextStep(const wstring &description)
+{
+  start(description);
+}
+
+void BenchmarkTimer::setSteps(const int)
+{
+  // The solution reports the number of steps when the project files are loaded.
+  finishPhase();
+}
+
+void BenchmarkTimer::start(const wstring &phase)
+{
+  finishPhase();
+
+  if (!_isRunning)
+  {
+    _runs.push_back(Run());
+    _isRunning=true;
+  }
+
+  _phase=phase;
+  _start=chrono::steady_clock::now();
+}
+
+void BenchmarkTimer::stop(const Solution &solution)
+{
+  Run
+    *run;
+
+  finishPhase();
+  if (!_isRunning)
+    return;
+
+  run=&_runs.back();
+  run->cacheHits=solution.configCache().hitCount();
+  run->cacheMisses=solution.configCache().missCount();
+  run->filesUnchanged=solution.outputWriter().unchangedCount();
+  run->filesWritten=solution.outputWriter().changedCount();
+  _isRunning=false;
+}
+
+void BenchmarkTimer::write(ostream &stream) const
+{
+  const char
+    *separator;
+
+  long long
+    projectFiles;
+
+  stream << "[";
+  for (size_t i=0; i < _runs.size(); i++)
+  {
+    const Run
+      &run=_runs[i];
+
+    stream << (i == 0 ? "" : ",") << endl;
+    stream << "    {" << endl;
+
+    projectFiles=0;
+    separator="";
+    stream << "      \"phases\": {";
+    for (auto& phase : run.phases)
+    {
+      if (startsWith(phase.name,projectFileStep))
+      {
+        projectFiles+=phase.microseconds;
+        continue;
+      }
+
+      stream << separator << endl << "        " << jsonString(phase.name) << ": " << phase.microseconds;
+      separator=",";
+    }
+    stream << separator << endl << "        \"Writing project files\": " << projectFiles << endl;
+    stream << "      }," << endl;
+
+    separator="";
+    stream << "      \"projectFiles\": {";
+    for (auto& phase : run.phases)
+    {
+      if (!startsWith(phase.name,projectFileStep))
+        continue;
+
+      stream << separator << endl << "        " << jsonString(phase.name.substr(projectFileStep.length())) << ": " << phase.microseconds;
+      separator=",";
+    }
+    stream << endl << "      }," << endl;
+
+    stream << "      \"configCache\": { \"hits\": " << run.cacheHits << ", \"misses\": " << run.cacheMisses << " }," << endl;
+    stream << "      \"output\": { \"written\": " << run.filesWritten << ", \"unchanged\": " << run.filesUnchanged << " }" << endl;
+    stream << "    }";
+  }
+  stream << endl << "  ]";
+}
+
+void BenchmarkTimer::finishPhase()
+{
+  Phase
+    phase;
+
+  if (_phase.empty())
+    return;
+
+  phase.name=_phase;
+  phase.microseconds=chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now()-_start).count();
+  _runs.back().phases.push_back(phase);
+  _phase=L"";
+}
@@ -0,0 +1,65 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __BenchmarkTimer__
+#define __BenchmarkTimer__
+
+#include "Progress.h"
+#include "Solution.h"
+
+class BenchmarkTimer : public Progress
+{
+public:
+  BenchmarkTimer();
+
+  void nextStep(const wstring &description);
+
+  void setSteps(const int steps);
+
+  void start(const wstring &phase);
+
+  void stop(const Solution &solution);
+
+  void write(ostream &stream) const;
+
+private:
+  struct Phase
+  {
+    wstring    name;
+    long long  microseconds;
+  };
+
+  struct Run
+  {
+    size_t         cacheHits;
+    size_t         cacheMisses;
+    size_t         filesUnchanged;
+    size_t         filesWritten;
+    vector<Phase>  phases;
+  };
+
+  void finishPhase();
+
+  bool                              _isRunning;
+  wstring                           _phase;
+  vector<Run>                       _runs;
+  chrono::steady_clock::time_point  _start;
+};
+
+#endif // __BenchmarkTimer__
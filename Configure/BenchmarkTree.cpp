@@ -0,0 +1,280 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "BenchmarkTree.h"
+#include <iomanip>
+
+static const wstring markerFileName=L".ConfigureBenchmark";
+
+BenchmarkTree::BenchmarkTree()
+{
+  _aliasCount=2;
+  _excludeCount=10;
+  _fileCount=20;
+  _moduleCount=100;
+  _projectCount=50;
+}
+
+int BenchmarkTree::aliasCount() const
+{
+  return(_aliasCount);
+}
+
+void BenchmarkTree::aliasCount(int value)
+{
+  _aliasCount=value;
+}
+
+int BenchmarkTree::excludeCount() const
+{
+  return(_excludeCount);
+}
+
+void BenchmarkTree::excludeCount(int value)
+{
+  _excludeCount=value;
+}
+
+int BenchmarkTree::fileCount() const
+{
+  return(_fileCount);
+}
+
+void BenchmarkTree::fileCount(int value)
+{
+  _fileCount=value;
+}
+
+int BenchmarkTree::moduleCount() const
+{
+  return(_moduleCount);
+}
+
+void BenchmarkTree::moduleCount(int value)
+{
+  _moduleCount=value;
+}
+
+int BenchmarkTree::projectCount() const
+{
+  return(_projectCount);
+}
+
+void BenchmarkTree::projectCount(int value)
+{
+  _projectCount=value;
+}
+
+void BenchmarkTree::create(const wstring &root) const
+{
+  filesystem::path
+    folder(root);
+
+  // Only a folder that was created by a previous run is removed, the benchmark should never delete other files.
+  if (filesystem::exists(folder))
+  {
+    if (!filesystem::is_empty(folder) && !filesystem::exists(folder / markerFileName))
+      throwException(L"Not a benchmark tree: " + root);
+
+    filesystem::remove_all(folder);
+  }
+
+  filesystem::create_directories(folder / L"Artifacts" / L"bin");
+  filesystem::create_directories(folder / L"Configure");
+  writeFile(folder / markerFileName,L"");
+
+  createImageMagick(folder);
+
+  for (int i=0; i < _projectCount; i++)
+    createLibrary(folder,i);
+
+  createModules(folder,L"coders",L"coder",L"[DLLMODULE]",L"IM_MOD");
+  createModules(folder,L"utilities",L"utility",L"[EXEMODULE]",L"UTIL");
+}
+
+void BenchmarkTree::createImageMagick(const filesystem::path &root) const
+{
+  filesystem::path
+    config(root / L"ImageMagick" / L"config");
+
+  const wstring
+    policies[] = { L"limited", L"open", L"secure", L"websafe" },
+    xmlFiles[] = { L"colors", L"english", L"locale", L"log", L"thresholds" };
+
+  for (auto& xmlFile : xmlFiles)
+    writeFile(config / (xmlFile + L".xml"),L"<" + xmlFile + L"/>\n");
+
+  for (auto& policy : policies)
+    writeFile(config / (L"policy-" + policy + L".xml"),L"<policymap/>\n");
+
+  writeFile(config / L"configure.xml.in",L"<configure name=\"VERSION\" value=\"@PACKAGE_BASE_VERSION@\"/>\n");
+
+  writeFile(root / L"ImageMagick" / L"LICENSE",L"Benchmark license\n");
+  writeFile(root / L"ImageMagick" / L"MagickCore" / L"version.h.in",
+    L"#define MagickLibVersionText \"@MAGICK_LIB_VERSION_TEXT@\"\n"
+    L"#define MagickReleaseDate \"@RELEASE_DATE@\"\n");
+  writeFile(root / L"ImageMagick" / L"m4" / L"version.m4",
+    L"m4_define([magick_is_beta], [n])\n"
+    L"m4_define([magick_library_current], [10])\n"
+    L"m4_define([magick_library_revision], [0])\n"
+    L"m4_define([magick_library_age], [0])\n"
+    L"m4_define([magick_lib_version], [0x710])\n"
+    L"m4_define([magick_major_version], [7])\n"
+    L"m4_define([magick_minor_version], [1])\n"
+    L"m4_define([magick_micro_version], [0])\n"
+    L"m4_define([magick_patchlevel_version], [0])\n"
+    L"m4_define([magickpp_library_current], [5])\n"
+    L"m4_define([magickpp_library_revision], [0])\n"
+    L"m4_define([magickpp_library_age], [0])\n");
+
+  writeFile(root / L"Build" / L"package.version.h.in",L"#define MagickppLibVersionText \"@MAGICKPP_LIB_VERSION_TEXT@\"\n");
+  writeFile(root / L"Installer" / L"Inno" / L"config.isx.in",L"#define public MagickPackageVersion \"@PACKAGE_FULL_VERSION@\"\n");
+  writeFile(root / L"Projects" / L"MagickCore" / L"magick-baseconfig.h.in",L"$$CONFIG$$\n");
+}
+
+void BenchmarkTree::createLibrary(const filesystem::path &root,const int index) const
+{
+  filesystem::path
+    folder;
+
+  wstring
+    name;
+
+  wstringstream
+    config;
+
+  name=libraryName(index);
+  folder=root / L"Dependencies" / name;
+
+  config << L"[STATIC]" << endl << endl;
+  config << L"[DIRECTORIES]" << endl << L"src" << endl << endl;
+  config << L"[INCLUDES]" << endl << L"include" << endl << endl;
+
+  // Every library depends on the previous one and on one halfway down the chain to give the graph some width.
+  if (index > 0)
+  {
+    config << L"[DEPENDENCIES]" << endl << libraryName(index-1) << endl;
+    if ((index/2) != (index-1))
+      config << libraryName(index/2) << endl;
+    config << endl;
+  }
+
+  if (_excludeCount > 0)
+  {
+    config << L"[EXCLUDES]" << endl;
+    for (int i=0; i < _excludeCount; i++)
+    {
+      if ((i % 5) == 4)
+        config << L"*_" << numberedName(L"skip",i) << L".c" << endl;
+      else
+        config << numberedName(L"skip",i) << L".c" << endl;
+    }
+    config << endl;
+  }
+
+  config << L"[LICENSE]" << endl << L"LICENSE" << endl;
+
+  writeFile(folder / L".ImageMagick" / L"Config.txt",config.str());
+  writeFile(folder / L".ImageMagick" / L"ImageMagick.version.h",L"#define DELEGATE_VERSION_NUM 1,0," + to_wstring(index) + L"\n");
+  writeFile(folder / L"LICENSE",L"License of " + name + L"\n");
+  writeFile(folder / L"include" / (name + L".h"),L"void " + name + L"(void);\n");
+
+  for (int i=0; i < _fileCount; i++)
+    writeFile(folder / L"src" / (numberedName(L"file",i) + L".c"),L"int " + numberedName(L"file",i) + L";\n");
+
+  for (int i=0; i < _excludeCount; i++)
+  {
+    if ((i % 5) == 4)
+      writeFile(folder / L"src" / (L"test_" + numberedName(L"skip",i) + L".c"),L"");
+    else
+      writeFile(folder / L"src" / (numberedName(L"skip",i) + L".c"),L"");
+  }
+}
+
+void BenchmarkTree::createModules(const filesystem::path &root,const wstring &name,const wstring &moduleName,const wstring &type,const wstring &prefix) const
+{
+  filesystem::path
+    configFolder(root / L"Projects" / name),
+    filesFolder(root / L"ImageMagick" / name);
+
+  wstring
+    module;
+
+  wstringstream
+    config;
+
+  config << type << endl << endl;
+  config << L"[MODULE_PREFIX]" << endl << prefix << endl << endl;
+  config << L"[DIRECTORIES]" << endl << L"." << endl;
+  writeFile(configFolder / L"Config.txt",config.str());
+
+  if (type == L"[EXEMODULE]")
+    writeFile(filesFolder / L"main.c",L"int main(void) { return(0); }\n");
+
+  for (int i=0; i < _moduleCount; i++)
+  {
+    module=numberedName(moduleName,i);
+    writeFile(filesFolder / (module + L".c"),L"int " + module + L";\n");
+    writeFile(filesFolder / (module + L".h"),L"extern int " + module + L";\n");
+
+    if (_projectCount > 0)
+      writeFile(configFolder / (L"Config." + module + L".txt"),L"[DEPENDENCIES]\n" + libraryName(i % _projectCount) + L"\n\n" +
+        L"[INCLUDES]\n" + libraryName(i % _projectCount) + L"->include\n");
+
+    if ((type == L"[EXEMODULE]") && (_aliasCount > 0))
+    {
+      wstring
+        aliases;
+
+      for (int j=0; j < _aliasCount; j++)
+        aliases+=numberedName(module + L"_alias",j) + L"\n";
+      writeFile(configFolder / (L"Aliases." + module + L".txt"),aliases);
+    }
+  }
+}
+
+wstring BenchmarkTree::libraryName(const int index)
+{
+  return(numberedName(L"lib",index));
+}
+
+wstring BenchmarkTree::numberedName(const wstring &prefix,const int index)
+{
+  wstringstream
+    name;
+
+  name << prefix << setw(4) << setfill(L'0') << index;
+  return(name.str());
+}
+
+void BenchmarkTree::writeFile(const filesystem::path &fileName,const wstring &content)
+{
+  ofstream
+    file;
+
+  filesystem::create_directories(fileName.parent_path());
+
+  file.open(fileName,ios::binary);
+  if (!file)
+    throwException(L"Unable to create: " + fileName.wstring());
+
+  file << wstringToString(content);
+  file.close();
+}
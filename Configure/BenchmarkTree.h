@@ -0,0 +1,67 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __BenchmarkTree__
+#define __BenchmarkTree__
+
+#include "Shared.h"
+
+class BenchmarkTree
+{
+public:
+  BenchmarkTree();
+
+  int aliasCount() const;
+  void aliasCount(int value);
+
+  int excludeCount() const;
+  void excludeCount(int value);
+
+  int fileCount() const;
+  void fileCount(int value);
+
+  int moduleCount() const;
+  void moduleCount(int value);
+
+  int projectCount() const;
+  void projectCount(int value);
+
+  void create(const wstring &root) const;
+
+private:
+  void createImageMagick(const filesystem::path &root) const;
+
+  void createLibrary(const filesystem::path &root,const int index) const;
+
+  void createModules(const filesystem::path &root,const wstring &name,const wstring &moduleName,const wstring &type,const wstring &prefix) const;
+
+  static wstring libraryName(const int index);
+
+  static wstring numberedName(const wstring &prefix,const int index);
+
+  static void writeFile(const filesystem::path &fileName,const wstring &content);
+
+  int  _aliasCount;
+  int  _excludeCount;
+  int  _fileCount;
+  int  _moduleCount;
+  int  _projectCount;
+};
+
+#endif // __BenchmarkTree__
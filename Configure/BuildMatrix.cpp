@@ -0,0 +1,77 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "BuildMatrix.h"
+
+BuildMatrix::BuildMatrix(Options &options,Solution &solution)
+  : _options(options),
+    _solution(solution)
+{
+}
+
+void BuildMatrix::write(const wstring &fileName,Progress &progress)
+{
+  size_t
+    index;
+
+  wifstream
+    matrix;
+
+  wstring
+    command,
+    line;
+
+  const Options
+    options(_options);
+
+  matrix.open(nativePath(fileName));
+  if (!matrix)
+    throwException(L"Unable to open matrix file: " + fileName);
+
+  // The cells are written one after another because every cell updates the same headers in the source tree
+  // and the same project folders. The command after the | is used to build a cell before the next one is written.
+  while (!matrix.eof())
+  {
+    line=readLine(matrix);
+    if (line.empty() || (line[0] == L'#'))
+      continue;
+
+    command=L"";
+    index=line.find(L'|');
+    if (index != wstring::npos)
+    {
+      command=trim(line.substr(index+1));
+      line=trim(line.substr(0,index));
+    }
+
+    _options=options;
+    _options.parseArguments(line);
+
+    cout << "Matrix: " << wstringToString(line) << endl;
+    _solution.write(progress);
+
+    if (!command.empty() && (system(wstringToString(command).c_str()) != 0))
+      throwException(L"Matrix command failed: " + command);
+  }
+
+  matrix.close();
+
+  _options=options;
+}
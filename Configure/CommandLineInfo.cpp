@@ -20,54 +20,15 @@
 #include "stdafx.h"
 #include "CommandLineInfo.h"
 
-CommandLineInfo::CommandLineInfo(const ConfigureWizard &wizard)
+CommandLineInfo::CommandLineInfo(Options &options)
+  : _options(options)
 {
-  _platform=wizard.platform();
-  _enableDpc=wizard.enableDpc();
-  _excludeAliases=wizard.excludeAliases();
-  _excludeDeprecated=wizard.excludeDeprecated();
-  _includeIncompatibleLicense=wizard.includeIncompatibleLicense();
-  _includeOptional=wizard.includeOptional();
-  _installedSupport=wizard.installedSupport();
   _noWizard=false;
-  _policyConfig=wizard.policyConfig();
-  _quantumDepth=wizard.quantumDepth();
-  _solutionType=wizard.solutionType();
-  _useHDRI=wizard.useHDRI();
-  _useOpenCL=true;
-  _useOpenMP=wizard.useOpenMP();
-  _visualStudioVersion=wizard.visualStudioVersion();
-  _zeroConfigurationSupport=wizard.zeroConfigurationSupport();
 }
 
-bool CommandLineInfo::enableDpc() const
+const wstring CommandLineInfo::matrixFile() const
 {
-  return(_enableDpc);
-}
-
-bool CommandLineInfo::excludeAliases() const
-{
-  return(_excludeAliases);
-}
-
-bool CommandLineInfo::excludeDeprecated() const
-{
-  return(_excludeDeprecated);
-}
-
-bool CommandLineInfo::includeIncompatibleLicense() const
-{
-  return(_includeIncompatibleLicense);
-}
-
-bool CommandLineInfo::includeOptional() const
-{
-  return(_includeOptional);
-}
-
-bool CommandLineInfo::installedSupport() const
-{
-  return(_installedSupport);
+  return(_matrixFile);
 }
 
 bool CommandLineInfo::noWizard() const
@@ -75,49 +36,9 @@ bool CommandLineInfo::noWizard() const
   return(_noWizard);
 }
 
-Platform CommandLineInfo::platform() const
-{
-  return(_platform);
-}
-
-PolicyConfig CommandLineInfo::policyConfig() const
-{
-  return(_policyConfig);
-}
-
-QuantumDepth CommandLineInfo::quantumDepth() const
-{
-  return(_quantumDepth);
-}
-
-SolutionType CommandLineInfo::solutionType() const
-{
-  return(_solutionType);
-}
-
-bool CommandLineInfo::useHDRI() const
-{
-  return(_useHDRI);
-}
-
-bool CommandLineInfo::useOpenCL() const
-{
-  return(_useOpenCL);
-}
-
-bool CommandLineInfo::useOpenMP() const
-{
-  return(_useOpenMP);
-}
-
-VisualStudioVersion CommandLineInfo::visualStudioVersion() const
-{
-  return(_visualStudioVersion);
-}
-
-bool CommandLineInfo::zeroConfigurationSupport() const
+const wstring CommandLineInfo::unknownArgument() const
 {
-  return(_zeroConfigurationSupport);
+  return(_unknownArgument);
 }
 
 void CommandLineInfo::ParseParam(const wchar_t* pszParam, BOOL bFlag, BOOL bLast)
@@ -125,62 +46,10 @@ void CommandLineInfo::ParseParam(const wchar_t* pszParam, BOOL bFlag, BOOL bLast
   if (!bFlag)
     return;
 
-  if (_wcsicmp(pszParam, L"arm64") == 0)
-    _platform=Platform::ARM64;
-  else if (_wcsicmp(pszParam, L"dmt") == 0)
-    _solutionType=SolutionType::DYNAMIC_MT;
-  else if (_wcsicmp(pszParam, L"deprecated") == 0)
-    _excludeDeprecated=FALSE;
-  else if (_wcsicmp(pszParam, L"smt") == 0)
-    _solutionType=SolutionType::STATIC_MT;
-  else if (_wcsicmp(pszParam, L"smtd") == 0)
-    _solutionType=SolutionType::STATIC_MTD;
-  else if (_wcsicmp(pszParam, L"hdri") == 0)
-    _useHDRI=true;
-  else if (_wcsicmp(pszParam, L"incompatibleLicense") == 0)
-     _includeIncompatibleLicense=true;
-  else if (_wcsicmp(pszParam, L"includeOptional") == 0)
-    _includeOptional=true;
-  else if (_wcsicmp(pszParam, L"installedSupport") == 0)
-    _installedSupport=true;
-  else if (_wcsicmp(pszParam, L"noAliases") == 0)
-    _excludeAliases=true;
-  else if (_wcsicmp(pszParam, L"noDpc") == 0)
-    _enableDpc=false;
-  else if (_wcsicmp(pszParam, L"noHdri") == 0)
-    _useHDRI=false;
-  else if (_wcsicmp(pszParam, L"noOpenMP") == 0)
-    _useOpenMP=false;
+  if (_wcsnicmp(pszParam, L"matrix:", 7) == 0)
+    _matrixFile=pszParam+7;
   else if (_wcsicmp(pszParam, L"noWizard") == 0)
     _noWizard=true;
-  else if (_wcsicmp(pszParam, L"LimitedPolicy") == 0)
-    _policyConfig=PolicyConfig::LIMITED;
-  else if (_wcsicmp(pszParam, L"openCL") == 0)
-    _useOpenCL=true;
-  else if (_wcsicmp(pszParam, L"OpenPolicy") == 0)
-    _policyConfig=PolicyConfig::OPEN;
-  else if (_wcsicmp(pszParam, L"Q8") == 0)
-    _quantumDepth=QuantumDepth::Q8;
-  else if (_wcsicmp(pszParam, L"Q16") == 0)
-    _quantumDepth=QuantumDepth::Q16;
-  else if (_wcsicmp(pszParam, L"Q32") == 0)
-    _quantumDepth=QuantumDepth::Q32;
-  else if (_wcsicmp(pszParam, L"Q64") == 0)
-    _quantumDepth=QuantumDepth::Q64;
-  else if (_wcsicmp(pszParam, L"SecurePolicy") == 0)
-    _policyConfig=PolicyConfig::SECURE;
-  else if (_wcsicmp(pszParam, L"x86") == 0)
-    _platform=Platform::X86;
-  else if (_wcsicmp(pszParam, L"x64") == 0)
-    _platform=Platform::X64;
-  else if (_wcsicmp(pszParam, L"VS2017") == 0)
-    _visualStudioVersion=VisualStudioVersion::VS2017;
-  else if (_wcsicmp(pszParam, L"VS2019") == 0)
-    _visualStudioVersion=VisualStudioVersion::VS2019;
-  else if (_wcsicmp(pszParam, L"VS2022") == 0)
-    _visualStudioVersion=VisualStudioVersion::VS2022;
-  else if (_wcsicmp(pszParam, L"WebSafePolicy") == 0)
-    _policyConfig=PolicyConfig::WEBSAFE;
-  else if (_wcsicmp(pszParam, L"zeroConfigurationSupport") == 0)
-    _zeroConfigurationSupport=true;
+  else if ((!_options.parseArgument(pszParam)) && (_unknownArgument.empty()))
+    _unknownArgument=pszParam;
 }
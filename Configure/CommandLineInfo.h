@@ -20,65 +20,26 @@
 #ifndef __CommandLineInfo__
 #define __CommandLineInfo__
 
-#include "ConfigureWizard.h"
-#include "Shared.h"
+#include "Options.h"
 
 class CommandLineInfo : public CCommandLineInfo
 {
 public:
-  CommandLineInfo(const ConfigureWizard &wizard);
+  CommandLineInfo(Options &options);
 
-  bool enableDpc() const;
-
-  bool excludeAliases() const;
-
-  bool excludeDeprecated() const;
-
-  bool includeIncompatibleLicense() const;
-
-  bool includeOptional() const;
-
-  bool installedSupport() const;
+  const wstring matrixFile() const;
 
   bool noWizard() const;
 
-  Platform platform() const;
-
-  PolicyConfig policyConfig() const;
-
-  QuantumDepth quantumDepth() const;
-
-  SolutionType solutionType() const;
-
-  bool useHDRI() const;
-
-  bool useOpenCL() const;
-
-  bool useOpenMP() const;
-
-  VisualStudioVersion visualStudioVersion() const;
-
-  bool zeroConfigurationSupport() const;
+  const wstring unknownArgument() const;
 
   virtual void ParseParam(const wchar_t* pszParam, BOOL bFlag, BOOL bLast);
 
 private:
-  Platform            _platform;
-  bool                _enableDpc;
-  bool                _excludeAliases;
-  bool                _excludeDeprecated;
-  bool                _includeIncompatibleLicense;
-  bool                _includeOptional;
-  bool                _installedSupport;
-  bool                _noWizard;
-  PolicyConfig        _policyConfig;
-  QuantumDepth        _quantumDepth;
-  SolutionType        _solutionType;
-  bool                _useHDRI;
-  bool                _useOpenCL;
-  bool                _useOpenMP;
-  VisualStudioVersion _visualStudioVersion;
-  bool                _zeroConfigurationSupport;
+  wstring  _matrixFile;
+  bool     _noWizard;
+  Options  &_options;
+  wstring  _unknownArgument;
 };
 
 #endif // __CommandLineInfo__
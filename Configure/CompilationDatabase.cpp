@@ -0,0 +1,53 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "CompilationDatabase.h"
+#include "Shared.h"
+
+CompilationDatabase::CompilationDatabase(const Options &options,const DependencyGraph &graph)
+  : _graph(graph),
+    _options(options)
+{
+}
+
+const wstring CompilationDatabase::fileName() const
+{
+  // The tools expect this exact name, each platform gets its own folder.
+  return(pathFromRoot(_options.solutionName() + L".Projects\\" + _options.platformAlias() + L"\\compile_commands.json"));
+}
+
+void CompilationDatabase::write(wostream &file) const
+{
+  vector<string>
+    commands;
+
+  wstring
+    directory;
+
+  directory=rootDirectory();
+
+  for (auto& projectFile : _graph.order())
+    projectFile->addCompileCommands(_graph,_options.compileCommandsCompiler(),directory,commands);
+
+  file << "[";
+  for (size_t i=0; i < commands.size(); i++)
+    file << (i == 0 ? "" : ",") << endl << wstring(commands[i].begin(),commands[i].end());
+  file << endl << "]" << endl;
+}
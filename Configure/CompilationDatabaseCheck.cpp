@@ -0,0 +1,625 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "BenchmarkTree.h"
+#include "CompilationDatabase.h"
+#include "Options.h"
+#include "Solution.h"
+#include <map>
+#include <set>
+
+// Checks that every command in compile_commands.json matches what MSBuild would use for the same file.
+
+static const wstring
+  rootPath(L"..\\..\\");
+
+class SilentProgress : public Progress
+{
+public:
+  void nextStep(const wstring &) {}
+
+  void setSteps(const int) {}
+};
+
+struct CompileSettings
+{
+  wstring         arch;
+  bool            cpp;
+  vector<wstring> defines;
+  wstring         floatingPoint;
+  vector<wstring> includes;
+  wstring         object;
+  wstring         precompiledHeader;
+  wstring         trimmedFolder;
+};
+
+static size_t
+  errorCount=0;
+
+static void usage()
+{
+  cerr << "Usage: CompilationDatabaseCheck [/root:<folder>] [/tree:<folder>] [options]" << endl;
+  cerr << "Writes compile_commands.json and the project files and checks that both use the same defines, include" << endl;
+  cerr << "directories, /arch and /fp flags, language, object file and precompiled header for every source file." << endl;
+  cerr << "A synthetic source tree is created in the root folder unless an existing tree is specified with /tree." << endl;
+  cerr << "The options are the same as the command line options of Configure." << endl;
+}
+
+static void error(const wstring &fileName,const wstring &message)
+{
+  errorCount++;
+  cerr << wstringToString(fileName) << ": " << wstringToString(message) << endl;
+}
+
+static wstring readFile(const wstring &fileName)
+{
+  ifstream
+    file;
+
+  string
+    content;
+
+  wstring
+    result;
+
+  file.open(nativePath(fileName),ios::binary);
+  if (!file)
+    throwException(L"Unable to open: " + fileName);
+
+  content.assign(istreambuf_iterator<char>(file),istreambuf_iterator<char>());
+  for (auto& c : content)
+  {
+    if (c != '\r')
+      result+=(wchar_t) (unsigned char) c;
+  }
+
+  return(result);
+}
+
+static wstring join(const vector<wstring> &values)
+{
+  wstring
+    result;
+
+  for (auto& value : values)
+    result+=(result.empty() ? L"" : L";") + value;
+
+  return(result);
+}
+
+static vector<wstring> split(const wstring &value)
+{
+  vector<wstring>
+    result;
+
+  wstring
+    item;
+
+  wstringstream
+    stream(value);
+
+  while (getline(stream,item,L';'))
+  {
+    if ((!item.empty()) && (item.find(L"%(") != 0))
+      result.push_back(item);
+  }
+
+  return(result);
+}
+
+// The backslashes before a quote follow the rules of the C runtime, 2n backslashes keep the quote and 2n+1 escape it.
+static vector<wstring> tokenize(const wstring &command)
+{
+  bool
+    quoted;
+
+  size_t
+    count;
+
+  vector<wstring>
+    tokens;
+
+  wstring
+    token;
+
+  quoted=false;
+  for (size_t i=0; i < command.length(); i++)
+  {
+    if (command[i] == L'\\')
+    {
+      for (count=0; (i < command.length()) && (command[i] == L'\\'); i++)
+        count++;
+      if ((i < command.length()) && (command[i] == L'"'))
+      {
+        token+=wstring(count/2,L'\\');
+        if ((count % 2) == 1)
+        {
+          token+=L'"';
+          continue;
+        }
+      }
+      else
+        token+=wstring(count,L'\\');
+      i--;
+    }
+    else if (command[i] == L'"')
+      quoted=!quoted;
+    else if ((!quoted) && (command[i] == L' '))
+    {
+      if (!token.empty())
+        tokens.push_back(token);
+      token.clear();
+    }
+    else
+      token+=command[i];
+  }
+  if (!token.empty())
+    tokens.push_back(token);
+
+  return(tokens);
+}
+
+static wstring parseString(const wstring &json,size_t &index)
+{
+  wstring
+    result;
+
+  if (json[index++] != L'"')
+    throwException(L"Expected a string in compile_commands.json");
+
+  while ((index < json.length()) && (json[index] != L'"'))
+  {
+    if (json[index] == L'\\')
+    {
+      index++;
+      if (json[index] == L'u')
+      {
+        result+=(wchar_t) stoi(json.substr(index+1,4),nullptr,16);
+        index+=4;
+      }
+      else
+        result+=json[index];
+    }
+    else
+      result+=json[index];
+    index++;
+  }
+  index++;
+
+  return(result);
+}
+
+static vector<map<wstring,wstring>> readCompileCommands(const wstring &fileName)
+{
+  map<wstring,wstring>
+    entry;
+
+  size_t
+    index;
+
+  vector<map<wstring,wstring>>
+    entries;
+
+  wstring
+    json,
+    key;
+
+  json=readFile(fileName);
+  for (index=0; index < json.length(); )
+  {
+    if (json[index] == L'{')
+      entry.clear();
+    else if (json[index] == L'}')
+      entries.push_back(entry);
+    else if (json[index] == L'"')
+    {
+      key=parseString(json,index);
+      while (json[index] != L':')
+        index++;
+      while (json[++index] != L'"')
+        ;
+      entry[key]=parseString(json,index);
+      continue;
+    }
+    index++;
+  }
+
+  return(entries);
+}
+
+static wstring element(const wstring &xml,const wstring &name)
+{
+  size_t
+    end,
+    start;
+
+  start=xml.find(L"<" + name + L">");
+  if (start == wstring::npos)
+    return(L"");
+
+  start+=name.length()+2;
+  end=xml.find(L"</" + name + L">",start);
+  return(xml.substr(start,end-start));
+}
+
+// The settings of the later groups win, just like they do in MSBuild.
+static wstring releaseSetting(const wstring &xml,const wstring &platform,const wstring &name)
+{
+  size_t
+    end,
+    start;
+
+  wstring
+    condition,
+    group,
+    result,
+    value;
+
+  condition=L"<ItemDefinitionGroup Condition=\"'$(Configuration)|$(Platform)'=='Release|" + platform + L"'\">";
+  for (start=xml.find(condition); start != wstring::npos; start=xml.find(condition,end))
+  {
+    end=xml.find(L"</ItemDefinitionGroup>",start);
+    group=element(xml.substr(start,end-start),L"ClCompile");
+    value=element(group,name);
+    if (!value.empty())
+      result=value;
+  }
+
+  return(result);
+}
+
+static wstring releaseIntermediateDirectory(const wstring &xml,const wstring &platform)
+{
+  size_t
+    start;
+
+  wstring
+    tag;
+
+  tag=L"<IntDir Condition=\"'$(Configuration)|$(Platform)'=='Release|" + platform + L"'\">";
+  start=xml.find(tag);
+  if (start == wstring::npos)
+    return(L"");
+
+  start+=tag.length();
+  return(xml.substr(start,xml.find(L'<',start)-start));
+}
+
+static map<wstring,wstring> compileItems(const wstring &xml)
+{
+  map<wstring,wstring>
+    items;
+
+  size_t
+    end,
+    start;
+
+  wstring
+    include,
+    tag;
+
+  tag=L"<ClCompile Include=\"";
+  for (start=xml.find(tag); start != wstring::npos; start=xml.find(tag,end))
+  {
+    start+=tag.length();
+    include=xml.substr(start,xml.find(L'"',start)-start);
+    end=xml.find(L'>',start);
+    if (xml[end-1] == L'/')
+      items[include]=L"";
+    else
+    {
+      start=end+1;
+      end=xml.find(L"</ClCompile>",start);
+      items[include]=xml.substr(start,end-start);
+    }
+  }
+
+  return(items);
+}
+
+static CompileSettings commandSettings(const wstring &command,const wstring &output)
+{
+  CompileSettings
+    settings;
+
+  settings.cpp=false;
+  for (auto& token : tokenize(command))
+  {
+    if (token.find(L"/D") == 0)
+      settings.defines.push_back(token.substr(2));
+    else if (token.find(L"/I") == 0)
+      settings.includes.push_back(token.substr(2));
+    else if (token.find(L"/arch:") == 0)
+      settings.arch=token.substr(6);
+    else if (token.find(L"/fp:") == 0)
+      settings.floatingPoint=token.substr(4);
+    else if (token == L"/std:c++17")
+      settings.cpp=true;
+    else if (token.find(L"/Yc") == 0)
+      settings.precompiledHeader=L"Create " + token.substr(3);
+    else if (token.find(L"/Yu") == 0)
+      settings.precompiledHeader=L"Use " + token.substr(3);
+    else if (token.find(L"/d1trimfile:") == 0)
+      settings.trimmedFolder=token.substr(12);
+  }
+  settings.object=output;
+
+  return(settings);
+}
+
+static CompileSettings projectSettings(const wstring &project,const wstring &properties,const wstring &platform,
+  const wstring &projectDirectory,const wstring &include,const wstring &metadata)
+{
+  CompileSettings
+    settings;
+
+  wstring
+    extension,
+    object,
+    precompiledHeader;
+
+  settings.defines=split(releaseSetting(properties,platform,L"PreprocessorDefinitions"));
+  for (auto& definition : split(releaseSetting(project,platform,L"PreprocessorDefinitions")))
+    settings.defines.push_back(definition);
+  if (element(project,L"CharacterSet") == L"Unicode")
+  {
+    settings.defines.push_back(L"UNICODE");
+    settings.defines.push_back(L"_UNICODE");
+  }
+  else
+    settings.defines.push_back(L"_MBCS");
+
+  for (auto& directory : split(releaseSetting(project,platform,L"AdditionalIncludeDirectories")))
+    settings.includes.push_back(directory.find(rootPath) == 0 ? directory.substr(rootPath.length()) : projectDirectory + L"\\" + directory);
+
+  for (auto& option : tokenize(releaseSetting(project,platform,L"AdditionalOptions")))
+  {
+    if (option.find(L"/arch:") == 0)
+      settings.arch=option.substr(6);
+  }
+
+  settings.floatingPoint=toLower(releaseSetting(project,platform,L"FloatingPointModel"));
+
+  extension=include.substr(include.find_last_of(L'.'));
+  settings.cpp=(extension == L".cpp") || (extension == L".cc") || (releaseSetting(project,platform,L"CompileAs") == L"CompileAsCpp") ||
+    (element(metadata,L"CompileAs") == L"CompileAsCpp");
+
+  object=element(metadata,L"ObjectFileName");
+  if (object.empty())
+  {
+    object=include.substr(include.find_last_of(L'\\') + 1);
+    object=object.substr(0,object.find_last_of(L'.')) + L".obj";
+  }
+  else
+    object=object.substr(wstring(L"$(IntDir)").length());
+  settings.object=projectDirectory + L"\\" + releaseIntermediateDirectory(project,platform) + object;
+
+  precompiledHeader=element(metadata,L"PrecompiledHeader");
+  if (precompiledHeader.empty())
+    precompiledHeader=releaseSetting(project,platform,L"PrecompiledHeader");
+  if (precompiledHeader == L"Create")
+    settings.precompiledHeader=L"Create " + releaseSetting(project,platform,L"PrecompiledHeaderFile");
+  else if (precompiledHeader == L"Use")
+    settings.precompiledHeader=L"Use " + releaseSetting(project,platform,L"PrecompiledHeaderFile");
+
+  return(settings);
+}
+
+static void compare(const wstring &fileName,const wstring &name,const wstring &expected,const wstring &actual)
+{
+  if (expected != actual)
+    error(fileName,name + L" is '" + actual + L"' in compile_commands.json and '" + expected + L"' in the project file");
+}
+
+static void compare(const wstring &fileName,const CompileSettings &expected,const CompileSettings &actual)
+{
+  set<wstring>
+    actualDefines(actual.defines.begin(),actual.defines.end()),
+    expectedDefines(expected.defines.begin(),expected.defines.end());
+
+  if (expectedDefines != actualDefines)
+  {
+    compare(fileName,L"The defines",join(vector<wstring>(expectedDefines.begin(),expectedDefines.end())),
+      join(vector<wstring>(actualDefines.begin(),actualDefines.end())));
+  }
+  // The order of the include directories matters because that decides which header is found.
+  compare(fileName,L"The include directories",join(expected.includes),join(actual.includes));
+  compare(fileName,L"/arch",expected.arch,actual.arch);
+  compare(fileName,L"/fp",expected.floatingPoint,actual.floatingPoint);
+  compare(fileName,L"The language",expected.cpp ? L"C++" : L"C",actual.cpp ? L"C++" : L"C");
+  compare(fileName,L"The object file",expected.object,actual.object);
+  compare(fileName,L"The precompiled header",expected.precompiledHeader,actual.precompiledHeader);
+  compare(fileName,L"The trimmed folder",expected.trimmedFolder,actual.trimmedFolder);
+}
+
+static size_t checkProject(const ProjectFile &projectFile,const Options &options,map<wstring,map<wstring,wstring>> &commands)
+{
+  CompileSettings
+    settings;
+
+  map<wstring,map<wstring,wstring>>::iterator
+    command;
+
+  size_t
+    count;
+
+  wstring
+    platform,
+    project,
+    projectDirectory,
+    properties,
+    source;
+
+  count=0;
+  platform=options.platformName();
+  projectDirectory=projectFile.projectDirectory();
+  project=readFile(pathFromRoot(projectDirectory + L"\\" + projectFile.fileName()));
+  properties=readFile(pathFromRoot(projectDirectory + L"\\..\\Solution.props"));
+
+  for (auto& item : compileItems(project))
+  {
+    if ((element(item.second,L"ExcludedFromBuild") == L"true") || (item.first.find(L".asm") != wstring::npos))
+      continue;
+
+    // The same source file can be compiled by more than one project, but every object file is unique.
+    source=item.first.find(rootPath) == 0 ? item.first.substr(rootPath.length()) : projectDirectory + L"\\" + item.first;
+    settings=projectSettings(project,properties,platform,projectDirectory,item.first,item.second);
+    command=commands.find(settings.object);
+    if (command == commands.end())
+    {
+      error(source,L"Is compiled to " + settings.object + L" by " + projectFile.fileName() + L" but has no entry in compile_commands.json");
+      continue;
+    }
+
+    // MSBuild trims the root folder from the debug information of a reproducible build, the commands should do the same.
+    if (properties.find(L"/d1trimfile:") != wstring::npos)
+      settings.trimmedFolder=command->second[L"directory"] + L"\\";
+    compare(source,L"The source file",source,command->second[L"file"]);
+    compare(source,settings,commandSettings(command->second[L"command"],command->second[L"output"]));
+    commands.erase(command);
+    count++;
+  }
+
+  return(count);
+}
+
+static void extendTree(const wstring &root)
+{
+  filesystem::path
+    path(root);
+  wofstream
+    file;
+
+  // The synthetic tree has no per file settings, these make sure the overrides of the project files are checked too.
+  file.open(path / L"Projects" / L"coders" / L"Config.coder0000.txt",ios::app);
+  file << endl << L"[CPP]" << endl << L"ImageMagick\\coders\\coder0000.c" << endl;
+  file.close();
+
+  file.open(path / L"Dependencies" / L"lib0000" / L".ImageMagick" / L"Config.txt",ios::app);
+  file << endl << L"[OPTIMIZATION]" << endl << L"floating_point=fast" << endl;
+  file << endl << L"[DIRECTORIES]" << endl << L"src\\extra" << endl;
+  file.close();
+
+  file.open(path / L"Dependencies" / L"lib0001" / L".ImageMagick" / L"Config.txt",ios::app);
+  file << endl << L"[PRECOMPILED_HEADER]" << endl << L"lib0001.h" << endl << L"file0003.c" << endl;
+  file.close();
+
+  filesystem::create_directories(path / L"Dependencies" / L"lib0000" / L"src" / L"extra");
+  file.open(path / L"Dependencies" / L"lib0000" / L"src" / L"extra" / L"file0000.c");
+  file << L"int extra_file0000(void) { return(0); }" << endl;
+  file.close();
+}
+
+int main(int argc,char *argv[])
+{
+  map<wstring,map<wstring,wstring>>
+    commands;
+
+  size_t
+    checked;
+
+  vector<wstring>
+    arguments;
+
+  wstring
+    root,
+    tree;
+
+  root=(filesystem::temp_directory_path() / L"CompilationDatabaseCheck").wstring();
+
+  try
+  {
+    for (int i=1; i < argc; i++)
+    {
+      wstring
+        argument(argv[i],argv[i]+strlen(argv[i]));
+
+      if ((argument.length() < 2) || ((argument[0] != L'/') && (argument[0] != L'-')))
+      {
+        usage();
+        return(1);
+      }
+
+      argument=argument.substr(1);
+      if (argument.find(L"root:") == 0)
+        root=argument.substr(5);
+      else if (argument.find(L"tree:") == 0)
+        tree=argument.substr(5);
+      else
+        arguments.push_back(argument);
+    }
+
+    if (tree.empty())
+    {
+      BenchmarkTree
+        benchmarkTree;
+
+      benchmarkTree.projectCount(5);
+      benchmarkTree.moduleCount(5);
+      benchmarkTree.fileCount(5);
+      benchmarkTree.create(root);
+      extendTree(root);
+      tree=root;
+    }
+    filesystem::current_path(filesystem::path(tree) / L"Configure");
+
+    // The options look at the tree so they can only be created after switching to it.
+    Options
+      options;
+
+    SilentProgress
+      progress;
+
+    options.parseArgument(L"compileCommands");
+    for (auto& argument : arguments)
+    {
+      if (!options.parseArgument(argument))
+      {
+        usage();
+        return(1);
+      }
+    }
+
+    Solution
+      solution(options);
+
+    solution.loadProjects();
+    solution.write(progress);
+
+    for (auto& entry : readCompileCommands(CompilationDatabase(options,solution.dependencyGraph()).fileName()))
+      commands[entry[L"output"]]=entry;
+
+    checked=0;
+    for (auto& projectFile : solution.dependencyGraph().order())
+      checked+=checkProject(*projectFile,options,commands);
+
+    for (auto& command : commands)
+      error(command.second[L"file"],L"Is compiled to " + command.first + L" in compile_commands.json but not by any project file");
+
+    cout << "Checked " << checked << " source files, " << errorCount << " differences found." << endl;
+  }
+  catch (exception &exception)
+  {
+    cerr << "Exception caught: " << exception.what() << endl;
+    return(1);
+  }
+
+  return(errorCount == 0 ? 0 : 1);
+}
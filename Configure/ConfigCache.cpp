@@ -0,0 +1,322 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "ConfigCache.h"
+#include "Shared.h"
+
+// Increase this when the layout of a record changes.
+static const unsigned int
+  cacheVersion=6;
+
+static void writeNumber(ostream &stream,const long long value)
+{
+  stream.write((const char *) &value,sizeof(value));
+}
+
+static void writeString(ostream &stream,const wstring &value)
+{
+  writeNumber(stream,(long long) value.length());
+  stream.write((const char *) value.data(),value.length()*sizeof(wchar_t));
+}
+
+static bool readNumber(istream &stream,long long &value)
+{
+  stream.read((char *) &value,sizeof(value));
+  return(stream.good());
+}
+
+static bool readString(istream &stream,wstring &value)
+{
+  long long
+    length;
+
+  if (!readNumber(stream,length) || (length < 0) || (length > 0x1000000))
+    return(false);
+
+  value.resize((size_t) length);
+  stream.read((char *) &value[0],length*sizeof(wchar_t));
+  return(stream.good());
+}
+
+ConfigCacheRecord::ConfigCacheRecord()
+{
+  _index=0;
+  _isLoading=false;
+}
+
+void ConfigCacheRecord::addFile(const wstring &fileName)
+{
+  _files.push_back(fileName);
+}
+
+bool ConfigCacheRecord::isLoading() const
+{
+  return(_isLoading);
+}
+
+void ConfigCacheRecord::value(bool &value)
+{
+  if (_isLoading)
+    value=next() == L"1";
+  else
+    _values.push_back(value ? L"1" : L"0");
+}
+
+void ConfigCacheRecord::value(int &value)
+{
+  if (_isLoading)
+    value=stoi(next());
+  else
+    _values.push_back(to_wstring(value));
+}
+
+void ConfigCacheRecord::value(wstring &value)
+{
+  if (_isLoading)
+    value=next();
+  else
+    _values.push_back(value);
+}
+
+void ConfigCacheRecord::value(vector<wstring> &value)
+{
+  int
+    count;
+
+  count=(int) value.size();
+  this->value(count);
+  if (_isLoading)
+    value.clear();
+  for (int i=0; i < count; i++)
+  {
+    if (_isLoading)
+      value.push_back(next());
+    else
+      _values.push_back(value[i]);
+  }
+}
+
+const wstring &ConfigCacheRecord::next()
+{
+  if (_index >= _values.size())
+    throwException(L"Invalid configuration cache record.");
+
+  return(_values[_index++]);
+}
+
+ConfigCache::ConfigCache(const wstring &fileName)
+  : _fileName(fileName)
+{
+  _hitCount=0;
+  _missCount=0;
+}
+
+bool ConfigCache::get(const wstring &key,ConfigCacheRecord &record)
+{
+  lock_guard<mutex> lock(_lock);
+
+  auto entry=_entries.find(key);
+  if (entry != _entries.end())
+  {
+    bool
+      valid;
+
+    // The files of an entry that was already used by this run are not checked again.
+    valid=true;
+    if (!entry->second.used)
+    {
+      for (auto& stamp : entry->second.stamps)
+      {
+        FileStamp
+          current;
+
+        current=createStamp(stamp.fileName);
+        if ((current.size != stamp.size) || (current.lastWriteTime != stamp.lastWriteTime))
+        {
+          valid=false;
+          break;
+        }
+      }
+    }
+
+    if (valid)
+    {
+      entry->second.used=true;
+      record._values=entry->second.values;
+      record._index=0;
+      record._isLoading=true;
+      _hitCount++;
+      return(true);
+    }
+  }
+
+  _missCount++;
+  return(false);
+}
+
+size_t ConfigCache::hitCount() const
+{
+  return(_hitCount);
+}
+
+void ConfigCache::load()
+{
+  ifstream
+    file;
+
+  long long
+    count,
+    header[2];
+
+  _entries.clear();
+
+  file.open(nativePath(_fileName),ios::binary);
+  if (!file)
+    return;
+
+  if (!readNumber(file,header[0]) || !readNumber(file,header[1]) || (header[0] != cacheVersion) ||
+      (header[1] != sizeof(wchar_t)) || !readNumber(file,count))
+    return;
+
+  for (long long i=0; i < count; i++)
+  {
+    Entry
+      entry;
+
+    long long
+      length;
+
+    wstring
+      key;
+
+    if (!readString(file,key) || !readNumber(file,length))
+      break;
+
+    entry.used=false;
+    for (long long j=0; j < length; j++)
+    {
+      FileStamp
+        stamp;
+
+      if (!readString(file,stamp.fileName) || !readNumber(file,stamp.size) || !readNumber(file,stamp.lastWriteTime))
+        return;
+
+      entry.stamps.push_back(stamp);
+    }
+
+    if (!readNumber(file,length))
+      return;
+
+    for (long long j=0; j < length; j++)
+    {
+      wstring
+        value;
+
+      if (!readString(file,value))
+        return;
+
+      entry.values.push_back(value);
+    }
+
+    _entries[key]=entry;
+  }
+}
+
+size_t ConfigCache::missCount() const
+{
+  return(_missCount);
+}
+
+void ConfigCache::save() const
+{
+  ofstream
+    file;
+
+  long long
+    count;
+
+  // Only the entries that were used by this run are kept so the cache does not keep growing.
+  count=0;
+  for (auto& entry : _entries)
+  {
+    if (entry.second.used)
+      count++;
+  }
+
+  file.open(nativePath(_fileName),ios::binary);
+  if (!file)
+    return;
+
+  writeNumber(file,cacheVersion);
+  writeNumber(file,sizeof(wchar_t));
+  writeNumber(file,count);
+  for (auto& entry : _entries)
+  {
+    if (!entry.second.used)
+      continue;
+
+    writeString(file,entry.first);
+    writeNumber(file,(long long) entry.second.stamps.size());
+    for (auto& stamp : entry.second.stamps)
+    {
+      writeString(file,stamp.fileName);
+      writeNumber(file,stamp.size);
+      writeNumber(file,stamp.lastWriteTime);
+    }
+    writeNumber(file,(long long) entry.second.values.size());
+    for (auto& value : entry.second.values)
+      writeString(file,value);
+  }
+}
+
+void ConfigCache::set(const wstring &key,const ConfigCacheRecord &record)
+{
+  Entry
+    entry;
+
+  entry.used=true;
+  for (auto& fileName : record._files)
+    entry.stamps.push_back(createStamp(fileName));
+  entry.values=record._values;
+
+  lock_guard<mutex> lock(_lock);
+  _entries[key]=entry;
+}
+
+ConfigCache::FileStamp ConfigCache::createStamp(const wstring &fileName)
+{
+  error_code
+    error;
+
+  FileStamp
+    stamp;
+
+  stamp.fileName=fileName;
+  stamp.size=(long long) filesystem::file_size(nativePath(fileName),error);
+  if (error)
+  {
+    stamp.size=-1;
+    stamp.lastWriteTime=0;
+    return(stamp);
+  }
+
+  stamp.lastWriteTime=(long long) filesystem::last_write_time(nativePath(fileName),error).time_since_epoch().count();
+  return(stamp);
+}
@@ -0,0 +1,94 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __ConfigCache__
+#define __ConfigCache__
+
+#include <unordered_map>
+
+class ConfigCacheRecord
+{
+public:
+  ConfigCacheRecord();
+
+  void addFile(const wstring &fileName);
+
+  bool isLoading() const;
+
+  void value(bool &value);
+
+  void value(int &value);
+
+  void value(wstring &value);
+
+  void value(vector<wstring> &value);
+
+private:
+  friend class ConfigCache;
+
+  const wstring &next();
+
+  vector<wstring> _files;
+  size_t          _index;
+  bool            _isLoading;
+  vector<wstring> _values;
+};
+
+class ConfigCache
+{
+public:
+  ConfigCache(const wstring &fileName);
+
+  bool get(const wstring &key,ConfigCacheRecord &record);
+
+  size_t hitCount() const;
+
+  void load();
+
+  size_t missCount() const;
+
+  void save() const;
+
+  void set(const wstring &key,const ConfigCacheRecord &record);
+
+private:
+  struct FileStamp
+  {
+    wstring   fileName;
+    long long lastWriteTime;
+    long long size;
+  };
+
+  struct Entry
+  {
+    vector<FileStamp> stamps;
+    bool              used;
+    vector<wstring>   values;
+  };
+
+  static FileStamp createStamp(const wstring &fileName);
+
+  unordered_map<wstring,Entry> _entries;
+  wstring                      _fileName;
+  size_t                       _hitCount;
+  mutex                        _lock;
+  size_t                       _missCount;
+};
+
+#endif // __ConfigCache__
@@ -18,6 +18,7 @@
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 */
 #include "stdafx.h"
+#include "BuildMatrix.h"
 #include "CommandLineInfo.h"
 #include "ConfigureApp.h"
 #include "ConfigureWizard.h"
@@ -32,40 +33,56 @@ ConfigureApp theApp;
 
 ConfigureApp::ConfigureApp()
 {
+  _exitCode=0;
 }
 
 BOOL ConfigureApp::Init()
 {
-  ConfigureWizard
-    wizard;
-  
   INT_PTR
     response;
 
+  Options
+    options;
+
   Solution
-    solution(wizard);
+    solution(options);
 
   WaitDialog
     waitDialog;
 
-  CommandLineInfo info=CommandLineInfo(wizard);
+  ConfigureWizard
+    wizard(options);
+
+  CommandLineInfo info=CommandLineInfo(options);
   ParseCommandLine(info);
 
-  wizard.parseCommandLineInfo(info);
+  // A mistyped option would silently generate a different solution.
+  if (!info.unknownArgument().empty())
+    throwException(L"Unknown option: /" + info.unknownArgument());
 
   solution.loadProjects();
 
   response=ID_WIZFINISH;
-  if (info.noWizard() == FALSE)
+  if ((info.noWizard() == FALSE) && info.matrixFile().empty())
     response=wizard.DoModal();
 
   if (response != ID_WIZFINISH)
     return(FALSE);
 
-  solution.write(waitDialog);
+  if (!info.matrixFile().empty())
+    BuildMatrix(options,solution).write(info.matrixFile(),waitDialog);
+  else
+    solution.write(waitDialog);
+
+  solution.printStatistics(cout);
   return(TRUE);
 }
 
+int ConfigureApp::ExitInstance()
+{
+  CWinApp::ExitInstance();
+  return(_exitCode);
+}
 
 BOOL ConfigureApp::InitInstance()
 {
@@ -78,6 +95,7 @@ BOOL ConfigureApp::InitInstance()
     }
     catch (exception ex)
     {
+      _exitCode=1;
       FILE *fpstderr = stderr;
       if (freopen_s(&fpstderr, "CONOUT$", "w", stderr) == 0)
       {
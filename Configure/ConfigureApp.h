@@ -30,6 +30,8 @@ public:
 
   ConfigureApp();
 
+  virtual int ExitInstance();
+
   virtual BOOL InitInstance();
 
   DECLARE_MESSAGE_MAP()
@@ -37,6 +39,8 @@ public:
 private:
 
   BOOL Init();
+
+  int _exitCode;
 };
 
 #endif // __ConfigureApp__
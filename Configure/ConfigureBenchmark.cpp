@@ -0,0 +1,310 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "BenchmarkTimer.h"
+#include "BenchmarkTree.h"
+#include "FileMatcher.h"
+#include "Options.h"
+#include "Solution.h"
+#include <random>
+
+static void usage()
+{
+  cerr << "Usage: ConfigureBenchmark [/root:<folder>] [/output:<file>] [/iterations:<count>]" << endl;
+  cerr << "                          [/projects:<count>] [/modules:<count>] [/files:<count>] [/excludes:<count>] [/aliases:<count>]" << endl;
+  cerr << "                          [options]" << endl;
+  cerr << "       ConfigureBenchmark /matcher [/iterations:<count>]" << endl;
+  cerr << "A synthetic source tree is created in the root folder and Configure is run on it for every iteration." << endl;
+  cerr << "The first iteration starts without a cache, the following ones measure an unchanged tree." << endl;
+  cerr << "The options are the same as the command line options of Configure, the project files are written with one thread" << endl;
+  cerr << "unless /threads:<count> is specified." << endl;
+  cerr << "With /matcher the exclude patterns are matched with contains and with a FileMatcher, the results of both are compared" << endl;
+  cerr << "and the time per file is written." << endl;
+}
+
+static wstring randomText(mt19937 &random,const size_t maxLength)
+{
+  const wstring
+    characters(L"ab_.*");
+
+  size_t
+    length;
+
+  wstring
+    text;
+
+  length=uniform_int_distribution<size_t>(0,maxLength)(random);
+  for (size_t i=0; i < length; i++)
+    text+=characters[uniform_int_distribution<size_t>(0,characters.length()-1)(random)];
+
+  return(text);
+}
+
+static void checkMatcher(const vector<wstring> &patterns,const vector<wstring> &names)
+{
+  FileMatcher
+    matcher(patterns);
+
+  for (auto& name : names)
+  {
+    if (matcher.matches(name) != contains(patterns,name))
+      throwException(L"The FileMatcher and contains disagree on: " + name);
+  }
+}
+
+static long long matchTime(const vector<wstring> &names,const int rounds,function<bool(const wstring &)> match)
+{
+  chrono::steady_clock::time_point
+    start;
+
+  size_t
+    matches;
+
+  matches=0;
+  start=chrono::steady_clock::now();
+  for (int i=0; i < rounds; i++)
+  {
+    for (auto& name : names)
+      matches+=match(name) ? 1 : 0;
+  }
+
+  // The number of matches is checked so the calls cannot be optimized away.
+  if (matches == 0)
+    throwException(L"No file was matched");
+
+  return(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now()-start).count()/(rounds*(long long) names.size()));
+}
+
+static void benchmarkMatcher(ostream &stream,const int iterations)
+{
+  long long
+    containsTime,
+    matcherTime;
+
+  mt19937
+    random(42);
+
+  vector<wstring>
+    names,
+    patterns;
+
+  // The patterns of the synthetic tree: exact names, '*name' suffixes and 'name*' patterns that match anywhere.
+  for (int i=0; i < 40; i++)
+    patterns.push_back(L"skip" + to_wstring(i) + L".c");
+  for (int i=0; i < 8; i++)
+  {
+    patterns.push_back(L"*_test" + to_wstring(i) + L".c");
+    patterns.push_back(L"generated" + to_wstring(i) + L"*");
+  }
+
+  for (int i=0; i < 500; i++)
+    names.push_back(L"file" + to_wstring(i) + L".c");
+  for (int i=0; i < 40; i++)
+  {
+    names.push_back(L"skip" + to_wstring(i) + L".c");
+    names.push_back(L"module_test" + to_wstring(i % 10) + L".c");
+    names.push_back(L"src_generated" + to_wstring(i % 10) + L".h");
+  }
+  checkMatcher(patterns,names);
+
+  // Short texts with a small alphabet hit the corner cases: stars in the middle and on both ends, overlapping patterns.
+  for (int i=0; i < 20000; i++)
+  {
+    vector<wstring>
+      randomNames,
+      randomPatterns;
+
+    for (int j=uniform_int_distribution<int>(1,4)(random); j > 0; j--)
+    {
+      randomPatterns.push_back(randomText(random,4));
+      if (randomPatterns.back().empty()) // Config.txt never contains an empty line as a pattern.
+        randomPatterns.back()=L"*";
+    }
+    for (int j=0; j < 16; j++)
+      randomNames.push_back(randomText(random,6));
+    checkMatcher(randomPatterns,randomNames);
+  }
+
+  FileMatcher
+    matcher(patterns);
+
+  containsTime=matchTime(names,iterations*100,[&patterns](const wstring &name) { return(contains(patterns,name)); });
+  matcherTime=matchTime(names,iterations*100,[&matcher](const wstring &name) { return(matcher.matches(name)); });
+
+  stream << "{" << endl;
+  stream << "  \"unit\": \"nanoseconds per file\"," << endl;
+  stream << "  \"patterns\": " << patterns.size() << "," << endl;
+  stream << "  \"files\": " << names.size() << "," << endl;
+  stream << "  \"contains\": " << containsTime << "," << endl;
+  stream << "  \"matcher\": " << matcherTime << endl;
+  stream << "}" << endl;
+}
+
+static bool parseCount(const wstring &argument,const wstring &name,int &value)
+{
+  if (argument.find(name + L":") != 0)
+    return(false);
+
+  value=stoi(argument.substr(name.length()+1));
+  if (value < 0)
+    throwException(L"Invalid count: " + argument);
+
+  return(true);
+}
+
+static void writeResults(ostream &stream,const BenchmarkTree &tree,const Options &options,const BenchmarkTimer &timer)
+{
+  stream << "{" << endl;
+  stream << "  \"unit\": \"microseconds\"," << endl;
+  stream << "  \"tree\": { \"projects\": " << tree.projectCount() << ", \"modules\": " << tree.moduleCount() << ", \"files\": " << tree.fileCount();
+  stream << ", \"excludes\": " << tree.excludeCount() << ", \"aliases\": " << tree.aliasCount() << " }," << endl;
+  stream << "  \"solution\": \"" << wstringToString(options.solutionName()) << "." << wstringToString(options.platformAlias()) << "\"," << endl;
+  stream << "  \"threads\": " << options.threadCount() << "," << endl;
+  stream << "  \"runs\": ";
+  timer.write(stream);
+  stream << endl << "}" << endl;
+}
+
+int main(int argc,char *argv[])
+{
+  BenchmarkTimer
+    timer;
+
+  BenchmarkTree
+    tree;
+
+  bool
+    matcher;
+
+  int
+    iterations;
+
+  vector<wstring>
+    arguments;
+
+  wstring
+    outputFile,
+    root;
+
+  iterations=2;
+  matcher=false;
+  root=(filesystem::temp_directory_path() / L"ConfigureBenchmark").wstring();
+
+  try
+  {
+    for (int i=1; i < argc; i++)
+    {
+      int
+        count;
+
+      wstring
+        argument(argv[i],argv[i]+strlen(argv[i]));
+
+      if ((argument.length() < 2) || ((argument[0] != L'/') && (argument[0] != L'-')))
+      {
+        usage();
+        return(1);
+      }
+
+      argument=argument.substr(1);
+      if (argument.find(L"root:") == 0)
+        root=argument.substr(5);
+      else if (argument.find(L"output:") == 0)
+        outputFile=argument.substr(7);
+      else if (argument == L"matcher")
+        matcher=true;
+      else if (parseCount(argument,L"iterations",iterations))
+        continue;
+      else if (parseCount(argument,L"projects",count))
+        tree.projectCount(count);
+      else if (parseCount(argument,L"modules",count))
+        tree.moduleCount(count);
+      else if (parseCount(argument,L"files",count))
+        tree.fileCount(count);
+      else if (parseCount(argument,L"excludes",count))
+        tree.excludeCount(count);
+      else if (parseCount(argument,L"aliases",count))
+        tree.aliasCount(count);
+      else
+        arguments.push_back(argument);
+    }
+
+    if (matcher)
+    {
+      benchmarkMatcher(cout,max(iterations,1));
+      return(0);
+    }
+
+    // The output file is relative to the folder the benchmark was started from.
+    if (!outputFile.empty())
+      outputFile=filesystem::absolute(outputFile).wstring();
+
+    tree.create(root);
+    filesystem::current_path(filesystem::path(root) / L"Configure");
+
+    // The options look at the tree so they can only be created after switching to it.
+    Options
+      options;
+
+    options.threadCount(1);
+    for (auto& argument : arguments)
+    {
+      if (!options.parseArgument(argument))
+      {
+        usage();
+        return(1);
+      }
+    }
+
+    for (int i=0; i < iterations; i++)
+    {
+      Solution
+        solution(options);
+
+      timer.start(L"loadProjects");
+      solution.loadProjects();
+      timer.start(L"loadProjectFiles");
+      solution.write(timer);
+      timer.stop(solution);
+    }
+
+    if (outputFile.empty())
+      writeResults(cout,tree,options,timer);
+    else
+    {
+      ofstream
+        output;
+
+      output.open(filesystem::path(outputFile));
+      if (!output)
+        throwException(L"Unable to create: " + outputFile);
+
+      writeResults(output,tree,options,timer);
+      output.close();
+    }
+  }
+  catch (exception &exception)
+  {
+    cerr << "Exception caught: " << exception.what() << endl;
+    return(1);
+  }
+
+  return(0);
+}
@@ -0,0 +1,128 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "BuildMatrix.h"
+#include "Options.h"
+#include "Solution.h"
+
+class ConsoleProgress : public Progress
+{
+public:
+  ConsoleProgress(bool verbose);
+
+  void nextStep(const wstring &description);
+
+  void setSteps(const int steps);
+
+private:
+  int  _current;
+  int  _steps;
+  bool _verbose;
+};
+
+ConsoleProgress::ConsoleProgress(bool verbose)
+{
+  _current=0;
+  _steps=0;
+  _verbose=verbose;
+}
+
+void ConsoleProgress::nextStep(const wstring &description)
+{
+  _current++;
+  if (_verbose)
+    cout << "[" << _current << "/" << _steps << "] " << wstringToString(description) << endl;
+}
+
+void ConsoleProgress::setSteps(const int steps)
+{
+  _current=0;
+  _steps=steps;
+}
+
+static void usage()
+{
+  cerr << "Usage: ConfigureCLI [/matrix:<file>] [/verbose] [options]" << endl;
+  cerr << "The options are the same as the command line options of Configure, for example /x64 /Q16 /hdri /dmt." << endl;
+}
+
+int main(int argc,char *argv[])
+{
+  bool
+    verbose;
+
+  Options
+    options;
+
+  wstring
+    matrixFile;
+
+  verbose=false;
+  for (int i=1; i < argc; i++)
+  {
+    wstring
+      argument(argv[i],argv[i]+strlen(argv[i]));
+
+    if ((argument.length() < 2) || ((argument[0] != L'/') && (argument[0] != L'-')))
+    {
+      usage();
+      return(1);
+    }
+
+    argument=argument.substr(1);
+    if (startsWithIgnoreCase(argument,L"matrix:"))
+      matrixFile=argument.substr(7);
+    else if (equalsIgnoreCase(argument,L"verbose"))
+      verbose=true;
+    else if (equalsIgnoreCase(argument,L"noWizard"))
+      continue;
+    else if (!options.parseArgument(argument))
+    {
+      cerr << "Unknown option: " << argv[i] << endl;
+      usage();
+      return(1);
+    }
+  }
+
+  try
+  {
+    ConsoleProgress
+      progress(verbose);
+
+    Solution
+      solution(options);
+
+    solution.loadProjects();
+
+    if (!matrixFile.empty())
+      BuildMatrix(options,solution).write(matrixFile,progress);
+    else
+      solution.write(progress);
+
+    solution.printStatistics(cout);
+  }
+  catch (exception &exception)
+  {
+    cerr << "Exception caught: " << exception.what() << endl;
+    return(1);
+  }
+
+  return(0);
+}
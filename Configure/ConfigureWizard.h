@@ -23,72 +23,18 @@
 #include "Pages\WelcomePage.h"
 #include "Pages\TargetPage.h"
 #include "Pages\FinishedPage.h"
-#include "Shared.h"
-
-class CommandLineInfo;
+#include "Options.h"
 
 class ConfigureWizard : public CPropertySheet
 {
   DECLARE_DYNAMIC(ConfigureWizard)
 
 public:
-  ConfigureWizard(CWnd* pWndParent = (CWnd *) NULL);
+  ConfigureWizard(Options &options,CWnd* pWndParent = (CWnd *) NULL);
 
   virtual ~ConfigureWizard();
 
-  const wstring binDirectory() const;
-
-  const wstring channelMaskDepth() const;
-
-  bool enableDpc() const;
-
-  bool excludeAliases() const;
-
-  bool excludeDeprecated() const;
-
-  bool includeIncompatibleLicense() const;
-
-  bool includeOptional() const;
-
-  bool installedSupport() const;
-
-  bool isImageMagick7() const;
-
-  const wstring machineName() const;
-
-  const wstring magickCoreProjectName() const;
-
-  Platform platform() const;
-
-  const wstring platformName() const;
-
-  const wstring platformAlias() const;
-
-  PolicyConfig policyConfig() const;
-
-  QuantumDepth quantumDepth() const;
-
-  const wstring quantumDepthBits() const;
-
-  const wstring solutionName() const;
-
-  SolutionType solutionType() const;
-
-  bool useHDRI() const;
-
-  bool useOpenCL() const;
-
-  bool useOpenMP() const;
-
-  void updateProjectNames(wstring &value) const;
-
-  VisualStudioVersion visualStudioVersion() const;
-
-  const wstring visualStudioVersionName() const;
-
-  bool zeroConfigurationSupport() const;
-
-  void parseCommandLineInfo(const CommandLineInfo &info);
+  virtual INT_PTR DoModal();
 
 protected:
 
@@ -97,7 +43,7 @@ protected:
 private:
 
   FinishedPage _finishedPage;
-  bool         _isImageMagick7; 
+  Options      &_options;
   TargetPage   _targetPage;
   WelcomePage  _welcomePage;
 };
@@ -0,0 +1,150 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "CriticalPath.h"
+#include <iomanip>
+#include <set>
+
+CriticalPath::CriticalPath(const DependencyGraph &graph)
+  : _graph(graph)
+{
+  _span=0;
+  _work=0;
+
+  // The order of the graph has every project file after the files it references, so their finish is already known.
+  for (auto& projectFile : _graph.order())
+  {
+    Node
+      node;
+
+    node.depth=0;
+    node.finish=0;
+    node.previous=(const ProjectFile *) NULL;
+    node.weight=projectFile->sourceFileCount();
+
+    for (auto& reference : _graph.references(projectFile))
+    {
+      const Node
+        &referenceNode=_nodes[reference];
+
+      if ((node.previous == (const ProjectFile *) NULL) || (referenceNode.finish > node.finish))
+      {
+        node.finish=referenceNode.finish;
+        node.previous=reference;
+      }
+      node.depth=max(node.depth,referenceNode.depth+1);
+    }
+    node.finish+=node.weight;
+
+    if (_widths.size() <= node.depth)
+      _widths.resize(node.depth+1);
+    _widths[node.depth]++;
+
+    _span=max(_span,node.finish);
+    _work+=node.weight;
+    _nodes[projectFile]=node;
+  }
+}
+
+size_t CriticalPath::span() const
+{
+  return(_span);
+}
+
+size_t CriticalPath::work() const
+{
+  return(_work);
+}
+
+void CriticalPath::write(wostream &stream,const wstring &solutionName,const size_t chainCount) const
+{
+  set<const ProjectFile*>
+    reported;
+
+  size_t
+    count,
+    widestDepth;
+
+  vector<const ProjectFile*>
+    ends;
+
+  widestDepth=0;
+  for (size_t i=0; i < _widths.size(); i++)
+  {
+    if (_widths[i] > _widths[widestDepth])
+      widestDepth=i;
+  }
+
+  stream << L"Critical path report for " << solutionName << endl << endl;
+  stream << L"Project files:  " << _nodes.size() << endl;
+  stream << L"Source files:   " << _work << L" (total work)" << endl;
+  stream << L"Critical path:  " << _span << L" source files" << endl;
+  if (_span > 0)
+    stream << L"Parallelism:    " << fixed << setprecision(2) << (double) _work/_span << L" (total work divided by the critical path)" << endl;
+  if (!_widths.empty())
+    stream << L"Widest level:   " << _widths[widestDepth] << L" project files at dependency depth " << widestDepth << endl;
+  stream << endl;
+
+  for (auto& projectFile : _graph.order())
+    ends.push_back(projectFile);
+  stable_sort(ends.begin(),ends.end(),[&](const ProjectFile *a,const ProjectFile *b)
+  {
+    return(_nodes.at(a).finish > _nodes.at(b).finish);
+  });
+
+  // A chain is only reported when it ends in a project file that is not part of a longer chain that was already reported.
+  stream << L"Longest chains, the first project file is built first:" << endl;
+  count=0;
+  for (auto& projectFile : ends)
+  {
+    vector<const ProjectFile*>
+      projectFiles;
+
+    if (count == chainCount)
+      break;
+
+    if (reported.find(projectFile) != reported.end())
+      continue;
+
+    projectFiles=chain(projectFile);
+    stream << endl << setw(8) << _nodes.at(projectFile).finish << L" ";
+    for (size_t i=0; i < projectFiles.size(); i++)
+    {
+      stream << (i == 0 ? L"" : L" -> ") << projectFiles[i]->name() << L" (" << _nodes.at(projectFiles[i]).weight << L")";
+      reported.insert(projectFiles[i]);
+    }
+    stream << endl;
+    count++;
+  }
+}
+
+const vector<const ProjectFile*> CriticalPath::chain(const ProjectFile *projectFile) const
+{
+  vector<const ProjectFile*>
+    projectFiles;
+
+  while (projectFile != (const ProjectFile *) NULL)
+  {
+    projectFiles.insert(projectFiles.begin(),projectFile);
+    projectFile=_nodes.at(projectFile).previous;
+  }
+
+  return(projectFiles);
+}
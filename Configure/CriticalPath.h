@@ -0,0 +1,54 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __CriticalPath__
+#define __CriticalPath__
+
+#include "DependencyGraph.h"
+
+class CriticalPath
+{
+public:
+  CriticalPath(const DependencyGraph &graph);
+
+  size_t span() const;
+
+  size_t work() const;
+
+  void write(wostream &stream,const wstring &solutionName,const size_t chainCount) const;
+
+private:
+  struct Node
+  {
+    size_t             depth;
+    size_t             finish;
+    const ProjectFile  *previous;
+    size_t             weight;
+  };
+
+  const vector<const ProjectFile*> chain(const ProjectFile *projectFile) const;
+
+  const DependencyGraph                   &_graph;
+  unordered_map<const ProjectFile*,Node>  _nodes;
+  size_t                                  _span;
+  vector<size_t>                          _widths;
+  size_t                                  _work;
+};
+
+#endif // __CriticalPath__
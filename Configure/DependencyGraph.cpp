@@ -0,0 +1,207 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "DependencyGraph.h"
+
+DependencyGraph::DependencyGraph()
+{
+}
+
+void DependencyGraph::build(const vector<Project*> &projects)
+{
+  map<wstring,vector<wstring>>
+    unresolved;
+
+  unordered_map<const ProjectFile*,int>
+    states;
+
+  vector<ProjectFile*>
+    path;
+
+  wstring
+    message;
+
+  _nodes.clear();
+  _order.clear();
+  _projects.clear();
+
+  for (auto& project : projects)
+    _projects.insert(make_pair(project->name(),project));
+
+  // Every name is resolved once here, the project files only look up their own node when they are written.
+  for (auto& project : projects)
+  {
+    for (auto& projectFile : project->files())
+    {
+      Node
+        &node=_nodes[projectFile];
+
+      for (auto& dependency : projectFile->dependencies())
+      {
+        const Project
+          *target;
+
+        size_t
+          index;
+
+        wstring
+          moduleName,
+          projectName;
+
+        projectName=dependency;
+        index=dependency.find(L">");
+        if (index != wstring::npos)
+        {
+          projectName=dependency.substr(0,index);
+          moduleName=dependency.substr(index+1);
+        }
+
+        target=find(projectName);
+        if (target == (const Project *) NULL)
+        {
+          addUnresolved(unresolved,projectName,projectFile);
+          continue;
+        }
+
+        for (auto& targetFile : target->files())
+        {
+          if (moduleName.empty() || targetFile->moduleName() == moduleName)
+            node.references.push_back(targetFile);
+        }
+      }
+
+      for (auto& include : projectFile->includes())
+      {
+        const Project
+          *target;
+
+        size_t
+          index;
+
+        index=include.find(L"->");
+        if (index == wstring::npos)
+        {
+          node.includeDirectories.push_back(project->filePath(include));
+          continue;
+        }
+
+        target=find(include.substr(0,index));
+        if (target == (const Project *) NULL)
+        {
+          addUnresolved(unresolved,include.substr(0,index),projectFile);
+          continue;
+        }
+
+        node.includeDirectories.push_back(target->filePath(include.substr(index+2)));
+      }
+    }
+  }
+
+  if (!unresolved.empty())
+  {
+    for (auto& name : unresolved)
+    {
+      message+=L"\n  " + name.first + L" (used by";
+      for (auto& projectName : name.second)
+        message+=L" " + projectName;
+      message+=L")";
+    }
+
+    throwException(L"Unable to resolve the following projects:" + message);
+  }
+
+  for (auto& project : projects)
+  {
+    for (auto& projectFile : project->files())
+      sort(projectFile,states,path);
+  }
+}
+
+void DependencyGraph::addUnresolved(map<wstring,vector<wstring>> &unresolved,const wstring &name,const ProjectFile *projectFile)
+{
+  vector<wstring>
+    &projectNames=unresolved[name];
+
+  if (projectNames.empty() || projectNames.back() != projectFile->name())
+    projectNames.push_back(projectFile->name());
+}
+
+const Project *DependencyGraph::find(const wstring &name) const
+{
+  auto project=_projects.find(name);
+  if (project == _projects.end())
+    return((const Project *) NULL);
+
+  return(project->second);
+}
+
+const vector<wstring> &DependencyGraph::includeDirectories(const ProjectFile *projectFile) const
+{
+  return(node(projectFile).includeDirectories);
+}
+
+const vector<ProjectFile*> &DependencyGraph::references(const ProjectFile *projectFile) const
+{
+  return(node(projectFile).references);
+}
+
+const vector<ProjectFile*> &DependencyGraph::order() const
+{
+  return(_order);
+}
+
+const DependencyGraph::Node &DependencyGraph::node(const ProjectFile *projectFile) const
+{
+  auto node=_nodes.find(projectFile);
+  if (node == _nodes.end())
+    throwException(L"Project file is not part of the dependency graph: " + projectFile->name());
+
+  return(node->second);
+}
+
+void DependencyGraph::sort(ProjectFile *projectFile,unordered_map<const ProjectFile*,int> &states,vector<ProjectFile*> &path)
+{
+  int
+    &state=states[projectFile];
+
+  wstring
+    cycle;
+
+  // The state is 1 while the references of the project file are visited and 2 when it has been added to the order.
+  if (state == 2)
+    return;
+
+  path.push_back(projectFile);
+  if (state == 1)
+  {
+    auto start=std::find(path.begin(),path.end(),projectFile);
+    for (auto it=start; it != path.end(); it++)
+      cycle+=(it == start ? L"" : L" -> ") + (*it)->name();
+    throwException(L"Dependency cycle: " + cycle);
+  }
+
+  state=1;
+  for (auto& reference : node(projectFile).references)
+    sort(reference,states,path);
+
+  states[projectFile]=2;
+  path.pop_back();
+  _order.push_back(projectFile);
+}
@@ -0,0 +1,60 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __DependencyGraph__
+#define __DependencyGraph__
+
+#include "Project.h"
+#include <map>
+#include <unordered_map>
+
+class DependencyGraph
+{
+public:
+  DependencyGraph();
+
+  void build(const vector<Project*> &projects);
+
+  const Project *find(const wstring &name) const;
+
+  const vector<wstring> &includeDirectories(const ProjectFile *projectFile) const;
+
+  const vector<ProjectFile*> &order() const;
+
+  const vector<ProjectFile*> &references(const ProjectFile *projectFile) const;
+
+private:
+  struct Node
+  {
+    vector<wstring>       includeDirectories;
+    vector<ProjectFile*>  references;
+  };
+
+  static void addUnresolved(map<wstring,vector<wstring>> &unresolved,const wstring &name,const ProjectFile *projectFile);
+
+  const Node &node(const ProjectFile *projectFile) const;
+
+  void sort(ProjectFile *projectFile,unordered_map<const ProjectFile*,int> &states,vector<ProjectFile*> &path);
+
+  unordered_map<const ProjectFile*,Node>  _nodes;
+  vector<ProjectFile*>                    _order;
+  unordered_map<wstring,const Project*>   _projects;
+};
+
+#endif // __DependencyGraph__
@@ -0,0 +1,149 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "DirectoryIndex.h"
+#include "Shared.h"
+
+DirectoryEntry::DirectoryEntry(const wstring &name,const bool isDirectory,const bool isRegularFile)
+  : _isDirectory(isDirectory),
+    _isRegularFile(isRegularFile),
+    _name(name)
+{
+}
+
+bool DirectoryEntry::isDirectory() const
+{
+  return(_isDirectory);
+}
+
+bool DirectoryEntry::isRegularFile() const
+{
+  return(_isRegularFile);
+}
+
+const wstring &DirectoryEntry::name() const
+{
+  return(_name);
+}
+
+DirectoryIndex::DirectoryIndex(const Trace &trace)
+  : _trace(trace)
+{
+  _directoryCount=0;
+  _queryCount=0;
+}
+
+size_t DirectoryIndex::directoryCount() const
+{
+  return(_directoryCount);
+}
+
+bool DirectoryIndex::directoryExists(const wstring &path)
+{
+  _queryCount++;
+  return(directory(path).exists);
+}
+
+const vector<DirectoryEntry> &DirectoryIndex::entries(const wstring &path)
+{
+  return(directory(path).entries);
+}
+
+bool DirectoryIndex::fileExists(const wstring &path)
+{
+  filesystem::path
+    file(nativePath(path));
+
+  _queryCount++;
+
+  const Directory
+    &parent=directory(file.parent_path().wstring());
+
+  auto entry=parent.names.find(key(file.filename().wstring()));
+  if (entry == parent.names.end())
+    return(false);
+
+  return(!parent.entries[entry->second].isDirectory());
+}
+
+size_t DirectoryIndex::queryCount() const
+{
+  return(_queryCount);
+}
+
+const DirectoryIndex::Directory &DirectoryIndex::directory(const wstring &path)
+{
+  error_code
+    error;
+
+  unique_ptr<Directory>
+    directory;
+
+  wstring
+    name;
+
+  name=key(path);
+
+  {
+    lock_guard<mutex> lock(_lock);
+    auto existing=_directories.find(name);
+    if (existing != _directories.end())
+      return(*existing->second);
+  }
+
+  // The listing is done without holding the lock, another thread might list the same folder
+  // at the same time but only the first result will be stored.
+  directory=make_unique<Directory>();
+  {
+    TraceEvent event(_trace,L"directory",L"List directory");
+    event.argument(L"path",path);
+
+    directory->exists=filesystem::is_directory(nativePath(path),error);
+    if (directory->exists)
+    {
+      for (const auto& entry : filesystem::directory_iterator(nativePath(path),error))
+      {
+        directory->names[key(entry.path().filename().wstring())]=directory->entries.size();
+        directory->entries.push_back(DirectoryEntry(entry.path().filename().wstring(),
+          entry.is_directory(error),entry.is_regular_file(error)));
+      }
+    }
+
+    event.argument(L"entries",directory->entries.size());
+  }
+
+  lock_guard<mutex> lock(_lock);
+  auto inserted=_directories.insert(make_pair(name,move(directory)));
+  if (inserted.second)
+    _directoryCount++;
+  return(*inserted.first->second);
+}
+
+wstring DirectoryIndex::key(const wstring &path)
+{
+  wstring
+    result;
+
+  result=nativePath(path).lexically_normal().wstring();
+  while (!result.empty() && (result.back() == L'\\' || result.back() == L'/'))
+    result.pop_back();
+  transform(result.begin(),result.end(),result.begin(),[](wchar_t c) { return towlower(c); });
+  return(result);
+}
@@ -0,0 +1,78 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __DirectoryIndex__
+#define __DirectoryIndex__
+
+#include <memory>
+#include <unordered_map>
+#include "Trace.h"
+
+class DirectoryEntry
+{
+public:
+  DirectoryEntry(const wstring &name,const bool isDirectory,const bool isRegularFile);
+
+  bool isDirectory() const;
+
+  bool isRegularFile() const;
+
+  const wstring &name() const;
+
+private:
+  bool    _isDirectory;
+  bool    _isRegularFile;
+  wstring _name;
+};
+
+class DirectoryIndex
+{
+public:
+  DirectoryIndex(const Trace &trace);
+
+  size_t directoryCount() const;
+
+  bool directoryExists(const wstring &path);
+
+  const vector<DirectoryEntry> &entries(const wstring &path);
+
+  bool fileExists(const wstring &path);
+
+  size_t queryCount() const;
+
+private:
+  struct Directory
+  {
+    bool                           exists;
+    vector<DirectoryEntry>         entries;
+    unordered_map<wstring,size_t>  names;
+  };
+
+  const Directory &directory(const wstring &path);
+
+  static wstring key(const wstring &path);
+
+  atomic<size_t>                             _directoryCount;
+  unordered_map<wstring,unique_ptr<Directory>> _directories;
+  mutex                                      _lock;
+  atomic<size_t>                             _queryCount;
+  const Trace                                &_trace;
+};
+
+#endif // __DirectoryIndex__
@@ -0,0 +1,113 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "FileMatcher.h"
+#include <algorithm>
+
+FileMatcher::FileMatcher()
+{
+}
+
+FileMatcher::FileMatcher(const vector<wstring> &patterns)
+{
+  for (auto& pattern : patterns)
+  {
+    if (pattern.empty())
+      continue;
+
+    _exact.insert(pattern);
+    if (pattern.front() == L'*')
+      insert(_suffixes,pattern.rbegin(),pattern.rend()-1);
+    if (pattern.back() == L'*')
+      insert(_substrings,pattern.begin(),pattern.end()-1);
+  }
+}
+
+bool FileMatcher::matches(const wstring &value) const
+{
+  if (_exact.find(value) != _exact.end())
+    return(true);
+
+  if (find(_suffixes,value.rbegin(),value.rend()))
+    return(true);
+
+  // A pattern that ends with a star matches anywhere in the value, just like startsWith does.
+  for (auto c=value.begin(); c != value.end(); ++c)
+  {
+    if (find(_substrings,c,value.end()))
+      return(true);
+  }
+
+  return(false);
+}
+
+template<typename Iterator>
+bool FileMatcher::find(const vector<Node> &trie,Iterator begin,Iterator end)
+{
+  size_t
+    node;
+
+  if (trie.empty())
+    return(false);
+
+  node=0;
+  for (Iterator c=begin; !trie[node].terminal; ++c)
+  {
+    if (c == end)
+      return(false);
+
+    auto child=find_if(trie[node].children.begin(),trie[node].children.end(),
+      [c](const pair<wchar_t,size_t> &p) { return(p.first == *c); });
+    if (child == trie[node].children.end())
+      return(false);
+
+    node=child->second;
+  }
+
+  return(true);
+}
+
+template<typename Iterator>
+void FileMatcher::insert(vector<Node> &trie,Iterator begin,Iterator end)
+{
+  size_t
+    node;
+
+  if (trie.empty())
+    trie.push_back(Node{false,{}});
+
+  node=0;
+  for (Iterator c=begin; c != end; ++c)
+  {
+    auto child=find_if(trie[node].children.begin(),trie[node].children.end(),
+      [c](const pair<wchar_t,size_t> &p) { return(p.first == *c); });
+    if (child != trie[node].children.end())
+    {
+      node=child->second;
+      continue;
+    }
+
+    trie[node].children.push_back(make_pair(*c,trie.size()));
+    node=trie.size();
+    trie.push_back(Node{false,{}});
+  }
+
+  trie[node].terminal=true;
+}
@@ -0,0 +1,52 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __FileMatcher__
+#define __FileMatcher__
+
+#include <unordered_set>
+
+class FileMatcher
+{
+public:
+  FileMatcher();
+
+  FileMatcher(const vector<wstring> &patterns);
+
+  bool matches(const wstring &value) const;
+
+private:
+  struct Node
+  {
+    bool                         terminal;
+    vector<pair<wchar_t,size_t>> children;
+  };
+
+  template<typename Iterator>
+  static bool find(const vector<Node> &trie,Iterator begin,Iterator end);
+
+  template<typename Iterator>
+  static void insert(vector<Node> &trie,Iterator begin,Iterator end);
+
+  unordered_set<wstring> _exact;
+  vector<Node>           _substrings;
+  vector<Node>           _suffixes;
+};
+
+#endif // __FileMatcher__
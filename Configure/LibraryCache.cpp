@@ -0,0 +1,165 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "LibraryCache.h"
+#include "Shared.h"
+#include <iomanip>
+
+LibraryCache::LibraryCache(const Options &options,const DependencyGraph &graph)
+  : _graph(graph),
+    _hitCount(0),
+    _missCount(0),
+    _options(options)
+{
+}
+
+size_t LibraryCache::hitCount() const
+{
+  return(_hitCount);
+}
+
+size_t LibraryCache::missCount() const
+{
+  return(_missCount);
+}
+
+void LibraryCache::add(ProjectFile *projectFile)
+{
+  bool
+    cached;
+
+  wstring
+    directory,
+    entry;
+
+  if (!projectFile->usesLibraryCache())
+    return;
+
+  entry=_options.libraryCacheDirectory();
+  while (!entry.empty() && ((entry.back() == L'\\') || (entry.back() == L'/')))
+    entry.pop_back();
+  entry+=L"\\" + projectFile->name() + L"\\" + fingerprint(projectFile);
+
+  // A relative folder is relative to the root folder, the project files are two folders deeper.
+  if (nativePath(entry).is_absolute())
+    directory=entry;
+  else
+  {
+    directory=L"..\\..\\" + entry;
+    entry=pathFromRoot(entry);
+  }
+
+  cached=filesystem::exists(nativePath(entry + L"\\" + projectFile->libraryName()));
+  if (cached)
+    _hitCount++;
+  else
+    _missCount++;
+
+  projectFile->libraryCache(directory,cached,cached ? L"" : inputs(projectFile));
+}
+
+const wstring LibraryCache::fingerprint(ProjectFile *projectFile)
+{
+  ifstream
+    file;
+
+  string
+    content;
+
+  vector<wstring>
+    &inputs=_inputs[projectFile],
+    files,
+    settings;
+
+  wstringstream
+    manifest,
+    result;
+
+  projectFile->loadSource();
+  projectFile->addFingerprint(_graph,settings,files);
+
+  for (auto& setting : settings)
+    manifest << setting << endl;
+
+  for (auto& fileName : files)
+  {
+    // The time is read first, a change while the file is read will then also be noticed by the build.
+    inputs.push_back(to_wstring(filesystem::last_write_time(nativePath(pathFromRoot(fileName))).time_since_epoch().count()) + L" ..\\..\\" + fileName);
+
+    file.open(nativePath(pathFromRoot(fileName)),ios::binary);
+    if (!file)
+      throwException(L"Unable to open: " + fileName);
+
+    content.assign(istreambuf_iterator<char>(file),istreambuf_iterator<char>());
+    file.close();
+
+    manifest << "file " << fileName << " " << hex << hash(content) << endl;
+  }
+
+  // The headers of the libraries that are used are covered by their own fingerprints.
+  for (auto& reference : _graph.references(projectFile))
+  {
+    auto
+      referenceFingerprint=_fingerprints.find(reference);
+
+    if (referenceFingerprint != _fingerprints.end())
+    {
+      manifest << "reference " << reference->name() << " " << referenceFingerprint->second << endl;
+      inputs.insert(inputs.end(),_inputs[reference].begin(),_inputs[reference].end());
+    }
+  }
+
+  result << hex << setw(16) << setfill(L'0') << hash(wstringToString(manifest.str()));
+  _fingerprints[projectFile]=result.str();
+  return(result.str());
+}
+
+const wstring LibraryCache::inputs(const ProjectFile *projectFile)
+{
+  vector<wstring>
+    &lines=_inputs[projectFile];
+
+  wstring
+    result;
+
+  // The build compares these times with the ones of the files, on Windows both count from 1601 in steps of 100 nanoseconds.
+  sort(lines.begin(),lines.end());
+  lines.erase(unique(lines.begin(),lines.end()),lines.end());
+  for (auto& line : lines)
+    result+=line + L"\n";
+
+  return(result);
+}
+
+unsigned long long LibraryCache::hash(const string &content)
+{
+  unsigned long long
+    value;
+
+  // FNV-1a, the fingerprints have to be the same for every build of Configure.
+  value=14695981039346656037ULL;
+  for (auto& c : content)
+  {
+    value^=(unsigned char) c;
+    value*=1099511628211ULL;
+  }
+
+  return(value);
+}
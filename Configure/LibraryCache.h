@@ -0,0 +1,52 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __LibraryCache__
+#define __LibraryCache__
+
+#include "DependencyGraph.h"
+#include "Options.h"
+
+class LibraryCache
+{
+public:
+  LibraryCache(const Options &options,const DependencyGraph &graph);
+
+  size_t hitCount() const;
+
+  size_t missCount() const;
+
+  void add(ProjectFile *projectFile);
+
+private:
+  const wstring fingerprint(ProjectFile *projectFile);
+
+  static unsigned long long hash(const string &content);
+
+  const wstring inputs(const ProjectFile *projectFile);
+
+  const DependencyGraph                             &_graph;
+  unordered_map<const ProjectFile*,wstring>         _fingerprints;
+  size_t                                            _hitCount;
+  unordered_map<const ProjectFile*,vector<wstring>> _inputs;
+  size_t                                            _missCount;
+  const Options                                     &_options;
+};
+
+#endif // __LibraryCache__
@@ -0,0 +1,117 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "NinjaFile.h"
+
+NinjaFile::NinjaFile(const Options &options,const DependencyGraph &graph)
+  : _graph(graph),
+    _options(options)
+{
+}
+
+const wstring NinjaFile::escape(const wstring &value)
+{
+  return(replace(value,L"$",L"$$"));
+}
+
+const wstring NinjaFile::escapePath(const wstring &path)
+{
+  return(replace(replace(escape(path),L" ",L"$ "),L":",L"$:"));
+}
+
+const wstring NinjaFile::fileName() const
+{
+  return(pathFromRoot(_options.solutionName() + L"." + _options.platformAlias() + L".ninja"));
+}
+
+void NinjaFile::write(wostream &file) const
+{
+  wstring
+    targets;
+
+  file << "# Generated by Configure, do not edit." << endl;
+  file << "ninja_required_version = 1.7" << endl;
+  file << endl;
+  writeRules(file);
+
+  for (auto& projectFile : _graph.order())
+  {
+    projectFile->writeNinja(file,_graph);
+    targets+=L" " + escapePath(projectFile->ninjaTarget());
+  }
+
+  file << "build all: phony" << targets << endl;
+  file << "default all" << endl;
+}
+
+void NinjaFile::writeRules(wostream &file) const
+{
+  bool
+    clang;
+
+  clang=_options.ninjaCompiler().find(L"clang") != wstring::npos;
+
+  file << "cc = " << _options.ninjaCompiler() << endl;
+  file << "lib = " << (clang ? "llvm-lib" : "lib") << endl;
+  file << "link = " << (clang ? "lld-link" : "link") << endl;
+  file << endl;
+  // The compilers are scheduled by ninja over all projects, the pool only limits the memory hungry linkers.
+  file << "pool link_pool" << endl;
+  file << "  depth = 4" << endl;
+  file << endl;
+  file << "rule cc" << endl;
+  file << "  command = $cc /nologo /showIncludes @$out.rsp /c $in /Fo$out" << endl;
+  file << "  deps = msvc" << endl;
+  file << "  description = CC $out" << endl;
+  file << "  rspfile = $out.rsp" << endl;
+  file << "  rspfile_content = $cflags $langflags $pchflags" << endl;
+  file << endl;
+  file << "rule rc" << endl;
+  file << "  command = rc /nologo /DNDEBUG /l0x0409 /fo$out $in" << endl;
+  file << "  description = RC $out" << endl;
+  file << endl;
+  file << "rule asm" << endl;
+  if (_options.platform() == Platform::ARM64)
+    file << "  command = armasm64 $in -o $out" << endl;
+  else if (_options.platform() == Platform::X86)
+    file << "  command = ml /nologo /c /Cx /safeseh /coff /Fo$out $in" << endl;
+  else
+    file << "  command = ml64 /nologo /c /Cx /Fo$out $in" << endl;
+  file << "  description = ASM $out" << endl;
+  file << endl;
+  file << "rule nasm" << endl;
+  file << "  command = Build\\nasm $nasmflags -o $out $in" << endl;
+  file << "  description = NASM $out" << endl;
+  file << endl;
+  file << "rule lib" << endl;
+  file << "  command = $lib /nologo $libflags /OUT:$out @$out.rsp" << endl;
+  file << "  description = LIB $out" << endl;
+  file << "  rspfile = $out.rsp" << endl;
+  file << "  rspfile_content = $in_newline" << endl;
+  file << "  pool = link_pool" << endl;
+  file << endl;
+  file << "rule link" << endl;
+  file << "  command = $link /nologo $ldflags /OUT:$out @$out.rsp" << endl;
+  file << "  description = LINK $out" << endl;
+  file << "  rspfile = $out.rsp" << endl;
+  file << "  rspfile_content = $in_newline $libs" << endl;
+  file << "  pool = link_pool" << endl;
+  file << endl;
+}
@@ -0,0 +1,46 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __NinjaFile__
+#define __NinjaFile__
+
+#include "DependencyGraph.h"
+#include "Options.h"
+
+class NinjaFile
+{
+public:
+  NinjaFile(const Options &options,const DependencyGraph &graph);
+
+  static const wstring escape(const wstring &value);
+
+  static const wstring escapePath(const wstring &path);
+
+  const wstring fileName() const;
+
+  void write(wostream &file) const;
+
+private:
+  void writeRules(wostream &file) const;
+
+  const DependencyGraph &_graph;
+  const Options         &_options;
+};
+
+#endif // __NinjaFile__
@@ -0,0 +1,119 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "OptimizationProfile.h"
+
+OptimizationProfile::OptimizationProfile()
+{
+  _inlineDepth=2;
+  _intrinsicFunctions=false;
+  _optimizeGlobalData=false;
+  _vectorizerReport=0;
+}
+
+OptimizationProfile::OptimizationProfile(const wstring &projectName,const vector<wstring> &settings)
+  : OptimizationProfile()
+{
+  for (auto& setting : settings)
+    parse(projectName,setting);
+}
+
+const wstring OptimizationProfile::additionalOptions() const
+{
+  wstring
+    options;
+
+  if (_inlineDepth == 3)
+    options+=L"/Ob3 ";
+  if (_optimizeGlobalData)
+    options+=L"/Gw ";
+  if (_vectorizerReport > 0)
+    options+=L"/Qvec-report:" + to_wstring(_vectorizerReport) + L" ";
+
+  return(options);
+}
+
+const wstring OptimizationProfile::favorSizeOrSpeed() const
+{
+  return(_favorSizeOrSpeed);
+}
+
+const wstring OptimizationProfile::floatingPointModel() const
+{
+  return(_floatingPointModel);
+}
+
+const wstring OptimizationProfile::inlineFunctionExpansion() const
+{
+  // MSBuild has no value for /Ob3, that depth is only passed through the additional options.
+  switch (_inlineDepth)
+  {
+    case 0: return(L"Disabled");
+    case 1: return(L"OnlyExplicitInline");
+    case 3: return(L"");
+    default: return(L"AnySuitable");
+  }
+}
+
+bool OptimizationProfile::intrinsicFunctions() const
+{
+  return(_intrinsicFunctions);
+}
+
+const wstring OptimizationProfile::optimization() const
+{
+  return(_favorSizeOrSpeed == L"Size" ? L"MinSpace" : L"MaxSpeed");
+}
+
+void OptimizationProfile::parse(const wstring &projectName,const wstring &setting)
+{
+  size_t
+    index;
+
+  wstring
+    key,
+    value;
+
+  index=setting.find(L'=');
+  key=trim(setting.substr(0,index));
+  if (index != wstring::npos)
+    value=trim(setting.substr(index+1));
+
+  if ((key == L"favor") && (value == L"size"))
+    _favorSizeOrSpeed=L"Size";
+  else if ((key == L"favor") && (value == L"speed"))
+    _favorSizeOrSpeed=L"Speed";
+  else if ((key == L"floating_point") && (value == L"fast"))
+    _floatingPointModel=L"Fast";
+  else if ((key == L"floating_point") && (value == L"precise"))
+    _floatingPointModel=L"Precise";
+  else if ((key == L"floating_point") && (value == L"strict"))
+    _floatingPointModel=L"Strict";
+  else if ((key == L"inline_depth") && (value.length() == 1) && (value[0] >= L'0') && (value[0] <= L'3'))
+    _inlineDepth=value[0]-L'0';
+  else if ((key == L"intrinsics") && (value.empty()))
+    _intrinsicFunctions=true;
+  else if ((key == L"optimize_global_data") && (value.empty()))
+    _optimizeGlobalData=true;
+  else if ((key == L"vectorizer_report") && ((value == L"1") || (value == L"2")))
+    _vectorizerReport=value[0]-L'0';
+  else
+    throwException(L"Invalid optimization setting '" + setting + L"' in: " + projectName);
+}
@@ -0,0 +1,55 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __OptimizationProfile__
+#define __OptimizationProfile__
+
+#include "Shared.h"
+
+class OptimizationProfile
+{
+public:
+  OptimizationProfile();
+
+  OptimizationProfile(const wstring &projectName,const vector<wstring> &settings);
+
+  const wstring additionalOptions() const;
+
+  const wstring favorSizeOrSpeed() const;
+
+  const wstring floatingPointModel() const;
+
+  const wstring inlineFunctionExpansion() const;
+
+  bool intrinsicFunctions() const;
+
+  const wstring optimization() const;
+
+private:
+  void parse(const wstring &projectName,const wstring &setting);
+
+  wstring _favorSizeOrSpeed;
+  wstring _floatingPointModel;
+  int     _inlineDepth;
+  bool    _intrinsicFunctions;
+  bool    _optimizeGlobalData;
+  int     _vectorizerReport;
+};
+
+#endif // __OptimizationProfile__
@@ -0,0 +1,771 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "Options.h"
+
+Options::Options()
+{
+  _isImageMagick7=filesystem::exists(nativePath(pathFromRoot(L"ImageMagick\\MagickCore")));
+
+  setVisualStudioVersion();
+
+#if _M_IX86
+  _platform=Platform::X86;
+#elif _M_ARM64
+  _platform=Platform::ARM64;
+#else
+  _platform=Platform::X64;
+#endif
+  _enableDpc=true;
+  _excludeAliases=false;
+  _excludeDeprecated=true;
+#ifdef DEBUG
+  _includeIncompatibleLicense=true;
+  _includeOptional=true;
+#else
+  _includeIncompatibleLicense=false;
+  _includeOptional=false;
+#endif
+  _installedSupport=false;
+  _instructionSet=InstructionSet::DEFAULT;
+  _linkTimeCodeGeneration=LinkTimeCodeGeneration::DISABLED;
+  _policyConfig=PolicyConfig::OPEN;
+  _precompiledHeaders=false;
+  _profileGuidedOptimization=false;
+  _quantumDepth=QuantumDepth::Q16;
+  _reproducible=false;
+  _shareDependencies=false;
+  _solutionFilters=false;
+  _solutionType=SolutionType::DYNAMIC_MT;
+  _unityBatchSize=0;
+  _useHDRI=_isImageMagick7;
+  _useOpenCL=true;
+  _useOpenMP=true;
+  _zeroConfigurationSupport=false;
+
+  _threadCount=(int) thread::hardware_concurrency();
+  if (_threadCount < 1)
+    _threadCount=1;
+}
+
+const wstring Options::artifactsDirectory(const bool variantSensitive,const wstring &configuration) const
+{
+  wstring
+    directory;
+
+  // The variants of an instruction set get their own folder so they can be built next to the default one.
+  directory=L"Artifacts\\";
+  if (!instructionSetName().empty())
+    directory+=instructionSetName() + L"\\";
+
+  if (variantSensitive && _shareDependencies)
+    directory+=variantName() + L"\\";
+
+  // The profile guided configurations link different images from the same objects.
+  if ((configuration == L"PGInstrument") || (configuration == L"PGOptimize"))
+    directory+=configuration + L"\\";
+
+  return(directory);
+}
+
+const wstring Options::binDirectory(const wstring &configuration) const
+{
+  return(artifactsDirectory(true,configuration) + L"bin\\");
+}
+
+const vector<wstring> Options::binDirectories() const
+{
+  vector<wstring>
+    directories;
+
+  for (auto& configuration : configurations())
+  {
+    if (find(directories.begin(),directories.end(),binDirectory(configuration)) == directories.end())
+      directories.push_back(binDirectory(configuration));
+  }
+
+  return(directories);
+}
+
+const wstring Options::channelMaskDepth() const
+{
+  if (!_isImageMagick7)
+    return(L"");
+
+  if ((visualStudioVersion() >= VisualStudioVersion::VS2022) && (platform() != Platform::X86))
+    return(L"64");
+  else
+    return(L"32");
+}
+
+const wstring Options::compileCommandsCompiler() const
+{
+  return(_compileCommandsCompiler);
+}
+
+void Options::compileCommandsCompiler(const wstring &value)
+{
+  _compileCommandsCompiler=value;
+}
+
+const vector<wstring> Options::configurations() const
+{
+  vector<wstring>
+    configurations;
+
+  configurations.push_back(L"Debug");
+  configurations.push_back(L"Release");
+  if (_profileGuidedOptimization)
+  {
+    configurations.push_back(L"PGInstrument");
+    configurations.push_back(L"PGOptimize");
+  }
+
+  return(configurations);
+}
+
+const wstring Options::criticalPathFile() const
+{
+  return(_criticalPathFile);
+}
+
+void Options::criticalPathFile(const wstring &value)
+{
+  _criticalPathFile=value;
+}
+
+bool Options::enableDpc() const
+{
+  return(_enableDpc);
+}
+
+void Options::enableDpc(bool value)
+{
+  _enableDpc=value;
+}
+
+bool Options::excludeAliases() const
+{
+  return(_excludeAliases);
+}
+
+void Options::excludeAliases(bool value)
+{
+  _excludeAliases=value;
+}
+
+bool Options::excludeDeprecated() const
+{
+  return(_excludeDeprecated);
+}
+
+void Options::excludeDeprecated(bool value)
+{
+  _excludeDeprecated=value;
+}
+
+const vector<wstring> &Options::formats() const
+{
+  return(_formats);
+}
+
+bool Options::includeIncompatibleLicense() const
+{
+  return(_includeIncompatibleLicense);
+}
+
+void Options::includeIncompatibleLicense(bool value)
+{
+  _includeIncompatibleLicense=value;
+}
+
+bool Options::includeOptional() const
+{
+  return(_includeOptional);
+}
+
+void Options::includeOptional(bool value)
+{
+  _includeOptional=value;
+}
+
+bool Options::installedSupport() const
+{
+  return(_installedSupport);
+}
+
+void Options::installedSupport(bool value)
+{
+  _installedSupport=value;
+}
+
+InstructionSet Options::instructionSet() const
+{
+  return(_instructionSet);
+}
+
+void Options::instructionSet(InstructionSet value)
+{
+  _instructionSet=value;
+}
+
+const wstring Options::instructionSetName() const
+{
+  switch (_instructionSet)
+  {
+    case InstructionSet::AVX2: return(_platform != Platform::ARM64 ? L"AVX2" : L"");
+    case InstructionSet::AVX512: return(_platform != Platform::ARM64 ? L"AVX512" : L"");
+    case InstructionSet::ARMV8_2: return(_platform == Platform::ARM64 ? L"armv8.2" : L"");
+    default: return(L"");
+  }
+}
+
+bool Options::isImageMagick7() const
+{
+  return(_isImageMagick7);
+}
+
+const wstring Options::libraryCacheDirectory() const
+{
+  return(_libraryCacheDirectory);
+}
+
+void Options::libraryCacheDirectory(const wstring &value)
+{
+  _libraryCacheDirectory=value;
+}
+
+LinkTimeCodeGeneration Options::linkTimeCodeGeneration() const
+{
+  return(_linkTimeCodeGeneration);
+}
+
+void Options::linkTimeCodeGeneration(LinkTimeCodeGeneration value)
+{
+  _linkTimeCodeGeneration=value;
+}
+
+const wstring Options::machineName() const
+{
+  switch (platform())
+  {
+    case Platform::X86: return(L"X86");
+    case Platform::X64: return(L"X64");
+    case Platform::ARM64: return(L"ARM64");
+    default: throw;
+  }
+}
+
+const wstring Options::magickCoreProjectName() const
+{
+  return(_isImageMagick7 ? L"MagickCore" : L"magick");
+}
+
+const wstring Options::ninjaCompiler() const
+{
+  return(_ninjaCompiler);
+}
+
+void Options::ninjaCompiler(const wstring &value)
+{
+  _ninjaCompiler=value;
+}
+
+Platform Options::platform() const
+{
+  return(_platform);
+}
+
+void Options::platform(Platform value)
+{
+  _platform=value;
+}
+
+const wstring Options::platformName() const
+{
+  switch (platform())
+  {
+    case Platform::X86: return(L"Win32");
+    case Platform::X64: return(L"x64");
+    case Platform::ARM64: return(L"ARM64");
+    default: throw;
+  }
+}
+
+const wstring Options::platformAlias() const
+{
+  switch (platform())
+  {
+    case Platform::X86: return(L"x86");
+    case Platform::X64: return(L"x64");
+    case Platform::ARM64: return(L"arm64");
+    default: throw;
+  }
+}
+
+const wstring Options::platformToolset() const
+{
+  switch(_visualStudioVersion)
+  {
+    case VisualStudioVersion::VS2017: return(L"v141");
+    case VisualStudioVersion::VS2019: return(L"v142");
+    case VisualStudioVersion::VS2022: return(L"v143");
+    default: throw;
+  }
+}
+
+PolicyConfig Options::policyConfig() const
+{
+  return(_policyConfig);
+}
+
+void Options::policyConfig(PolicyConfig value)
+{
+  _policyConfig=value;
+}
+
+bool Options::precompiledHeaders() const
+{
+  return(_precompiledHeaders);
+}
+
+void Options::precompiledHeaders(bool value)
+{
+  _precompiledHeaders=value;
+}
+
+bool Options::profileGuidedOptimization() const
+{
+  return(_profileGuidedOptimization);
+}
+
+void Options::profileGuidedOptimization(bool value)
+{
+  _profileGuidedOptimization=value;
+}
+
+QuantumDepth Options::quantumDepth() const
+{
+  return(_quantumDepth);
+}
+
+void Options::quantumDepth(QuantumDepth value)
+{
+  _quantumDepth=value;
+}
+
+const wstring Options::quantumDepthBits() const
+{
+  switch (quantumDepth())
+  {
+    case QuantumDepth::Q8: return(L"8");
+    case QuantumDepth::Q16: return(L"16"); 
+    case QuantumDepth::Q32: return(L"32"); 
+    case QuantumDepth::Q64: return(L"64"); 
+    default: throw;
+  }
+}
+
+bool Options::reproducible() const
+{
+  return(_reproducible);
+}
+
+void Options::reproducible(bool value)
+{
+  _reproducible=value;
+}
+
+bool Options::shareDependencies() const
+{
+  return(_shareDependencies);
+}
+
+void Options::shareDependencies(bool value)
+{
+  _shareDependencies=value;
+}
+
+const wstring Options::sharedSolutionName() const
+{
+  wstring
+    name;
+
+  name=_isImageMagick7 ? L"IM7." : L"IM6.";
+  if (solutionType() == SolutionType::DYNAMIC_MT)
+    name+=L"Dynamic";
+  else if (solutionType() == SolutionType::STATIC_MTD)
+    name+=L"StaticDLL";
+  else if (solutionType() == SolutionType::STATIC_MT)
+    name+=L"Static";
+  else
+    return(L"ThisShouldNeverHappen");
+
+  if (!instructionSetName().empty())
+    name+=L"." + instructionSetName();
+
+  return(name);
+}
+
+const wstring Options::solutionName() const
+{
+  // The projects that do not depend on the quantum depth or HDRI stay in the folder of the shared solution name.
+  if (!_shareDependencies)
+    return(sharedSolutionName());
+
+  return(sharedSolutionName() + L"." + variantName());
+}
+
+bool Options::solutionFilters() const
+{
+  return(_solutionFilters);
+}
+
+void Options::solutionFilters(bool value)
+{
+  _solutionFilters=value;
+}
+
+const vector<wstring> &Options::solutionFilterProjects() const
+{
+  return(_solutionFilterProjects);
+}
+
+SolutionType Options::solutionType() const
+{
+  return(_solutionType);
+}
+
+void Options::solutionType(SolutionType value)
+{
+  _solutionType=value;
+}
+
+int Options::threadCount() const
+{
+  return(_threadCount);
+}
+
+void Options::threadCount(int value)
+{
+  _threadCount=value;
+}
+
+const wstring Options::traceFile() const
+{
+  return(_traceFile);
+}
+
+void Options::traceFile(const wstring &value)
+{
+  _traceFile=value;
+}
+
+int Options::unityBatchSize() const
+{
+  return(_unityBatchSize);
+}
+
+void Options::unityBatchSize(int value)
+{
+  _unityBatchSize=value;
+}
+
+bool Options::useHDRI() const
+{
+  return(_useHDRI);
+}
+
+void Options::useHDRI(bool value)
+{
+  _useHDRI=value;
+}
+
+bool Options::useOpenCL() const
+{
+  return(_useOpenCL);
+}
+
+void Options::useOpenCL(bool value)
+{
+  _useOpenCL=value;
+}
+
+bool Options::useOpenMP() const
+{
+  return(_useOpenMP);
+}
+
+void Options::useOpenMP(bool value)
+{
+  _useOpenMP=value;
+}
+
+void Options::updateProjectNames(wstring &value) const
+{
+  size_t
+    pos;
+
+  if (_isImageMagick7)
+    return;
+
+  pos=value.find(L"MagickCore");
+  if (pos != std::wstring::npos)
+    value.replace(pos,10,L"magick");
+
+  pos=value.find(L"MagickWand");
+  if (pos != std::wstring::npos)
+    value.replace(pos,10,L"wand");
+}
+
+const wstring Options::variantName() const
+{
+  return(L"Q" + quantumDepthBits() + (_useHDRI ? L"-HDRI" : L""));
+}
+
+VisualStudioVersion Options::visualStudioVersion() const
+{
+  return(_visualStudioVersion);
+}
+
+void Options::visualStudioVersion(VisualStudioVersion value)
+{
+  _visualStudioVersion=value;
+}
+
+const wstring Options::visualStudioVersionName() const
+{
+  switch(_visualStudioVersion)
+  {
+    case VisualStudioVersion::VS2017: return(L"VS2017");
+    case VisualStudioVersion::VS2019: return(L"VS2019");
+    case VisualStudioVersion::VS2022: return(L"VS2022");
+    default: return(L"VS");
+  }
+}
+
+bool Options::zeroConfigurationSupport() const
+{
+  return(_zeroConfigurationSupport);
+}
+
+void Options::zeroConfigurationSupport(bool value)
+{
+  _zeroConfigurationSupport=value;
+}
+
+bool Options::parseArgument(const wstring &argument)
+{
+  if (equalsIgnoreCase(argument,L"arm64"))
+    _platform=Platform::ARM64;
+  else if (equalsIgnoreCase(argument,L"armv8.2"))
+    _instructionSet=InstructionSet::ARMV8_2;
+  else if (equalsIgnoreCase(argument,L"AVX2"))
+    _instructionSet=InstructionSet::AVX2;
+  else if (equalsIgnoreCase(argument,L"AVX512"))
+    _instructionSet=InstructionSet::AVX512;
+  else if (equalsIgnoreCase(argument,L"compileCommands"))
+    _compileCommandsCompiler=L"cl";
+  else if (startsWithIgnoreCase(argument,L"compileCommands:"))
+    _compileCommandsCompiler=argument.substr(16);
+  else if (startsWithIgnoreCase(argument,L"criticalPath:"))
+    _criticalPathFile=argument.substr(13);
+  else if (equalsIgnoreCase(argument,L"dmt"))
+    _solutionType=SolutionType::DYNAMIC_MT;
+  else if (equalsIgnoreCase(argument,L"deprecated"))
+    _excludeDeprecated=false;
+  else if (startsWithIgnoreCase(argument,L"formats:"))
+  {
+    wstring
+      format;
+
+    wstringstream
+      wss(argument.substr(8));
+
+    while (getline(wss,format,L','))
+    {
+      format=toLower(format);
+      if (!format.empty() && !contains(_formats,format))
+        _formats.push_back(format);
+    }
+  }
+  else if (equalsIgnoreCase(argument,L"smt"))
+    _solutionType=SolutionType::STATIC_MT;
+  else if (equalsIgnoreCase(argument,L"smtd"))
+    _solutionType=SolutionType::STATIC_MTD;
+  else if (equalsIgnoreCase(argument,L"hdri"))
+    _useHDRI=true;
+  else if (equalsIgnoreCase(argument,L"incompatibleLicense"))
+    _includeIncompatibleLicense=true;
+  else if (equalsIgnoreCase(argument,L"includeOptional"))
+    _includeOptional=true;
+  else if (equalsIgnoreCase(argument,L"installedSupport"))
+    _installedSupport=true;
+  else if (equalsIgnoreCase(argument,L"ninja"))
+    _ninjaCompiler=L"cl";
+  else if (startsWithIgnoreCase(argument,L"ninja:"))
+    _ninjaCompiler=argument.substr(6);
+  else if (equalsIgnoreCase(argument,L"noAliases"))
+    _excludeAliases=true;
+  else if (equalsIgnoreCase(argument,L"noDpc"))
+    _enableDpc=false;
+  else if (equalsIgnoreCase(argument,L"noHdri"))
+    _useHDRI=false;
+  else if (equalsIgnoreCase(argument,L"noOpenMP"))
+    _useOpenMP=false;
+  else if (startsWithIgnoreCase(argument,L"libraryCache:"))
+    _libraryCacheDirectory=argument.substr(13);
+  else if (equalsIgnoreCase(argument,L"ltcg"))
+    _linkTimeCodeGeneration=LinkTimeCodeGeneration::FULL;
+  else if (equalsIgnoreCase(argument,L"ltcgIncremental"))
+    _linkTimeCodeGeneration=LinkTimeCodeGeneration::INCREMENTAL;
+  else if (equalsIgnoreCase(argument,L"LimitedPolicy"))
+    _policyConfig=PolicyConfig::LIMITED;
+  else if (equalsIgnoreCase(argument,L"openCL"))
+    _useOpenCL=true;
+  else if (equalsIgnoreCase(argument,L"OpenPolicy"))
+    _policyConfig=PolicyConfig::OPEN;
+  else if (equalsIgnoreCase(argument,L"pch"))
+    _precompiledHeaders=true;
+  else if (equalsIgnoreCase(argument,L"pgo"))
+    _profileGuidedOptimization=true;
+  else if (equalsIgnoreCase(argument,L"Q8"))
+    _quantumDepth=QuantumDepth::Q8;
+  else if (equalsIgnoreCase(argument,L"Q16"))
+    _quantumDepth=QuantumDepth::Q16;
+  else if (equalsIgnoreCase(argument,L"Q32"))
+    _quantumDepth=QuantumDepth::Q32;
+  else if (equalsIgnoreCase(argument,L"Q64"))
+    _quantumDepth=QuantumDepth::Q64;
+  else if (equalsIgnoreCase(argument,L"reproducible"))
+    _reproducible=true;
+  else if (equalsIgnoreCase(argument,L"SecurePolicy"))
+    _policyConfig=PolicyConfig::SECURE;
+  else if (equalsIgnoreCase(argument,L"shareDependencies"))
+    _shareDependencies=true;
+  else if (equalsIgnoreCase(argument,L"slnf"))
+    _solutionFilters=true;
+  else if (startsWithIgnoreCase(argument,L"slnf:"))
+  {
+    _solutionFilters=true;
+    _solutionFilterProjects.push_back(argument.substr(5));
+  }
+  else if (startsWithIgnoreCase(argument,L"threads:"))
+  {
+    if (wcstol(argument.c_str()+8,NULL,10) > 0)
+      _threadCount=(int) wcstol(argument.c_str()+8,NULL,10);
+  }
+  else if (startsWithIgnoreCase(argument,L"trace:"))
+    _traceFile=argument.substr(6);
+  else if (startsWithIgnoreCase(argument,L"unity:"))
+    _unityBatchSize=(int) wcstol(argument.c_str()+6,NULL,10);
+  else if (equalsIgnoreCase(argument,L"x86"))
+    _platform=Platform::X86;
+  else if (equalsIgnoreCase(argument,L"x64"))
+    _platform=Platform::X64;
+  else if (equalsIgnoreCase(argument,L"VS2017"))
+    _visualStudioVersion=VisualStudioVersion::VS2017;
+  else if (equalsIgnoreCase(argument,L"VS2019"))
+    _visualStudioVersion=VisualStudioVersion::VS2019;
+  else if (equalsIgnoreCase(argument,L"VS2022"))
+    _visualStudioVersion=VisualStudioVersion::VS2022;
+  else if (equalsIgnoreCase(argument,L"WebSafePolicy"))
+    _policyConfig=PolicyConfig::WEBSAFE;
+  else if (equalsIgnoreCase(argument,L"zeroConfigurationSupport"))
+    _zeroConfigurationSupport=true;
+  else
+    return(false);
+
+  return(true);
+}
+
+void Options::parseArguments(const wstring &arguments)
+{
+  wstring
+    argument;
+
+  wstringstream
+    wss(arguments);
+
+  while (wss >> argument)
+  {
+    if (((argument[0] != L'/') && (argument[0] != L'-')) || (!parseArgument(argument.substr(1))))
+      throwException(L"Invalid argument: " + argument);
+  }
+}
+
+wstring Options::getEnvironmentVariable(const wchar_t *name)
+{
+#ifdef _WIN32
+  wchar_t
+    *buffer;
+
+  size_t
+    length;
+
+  wstring
+    value;
+
+  if (_wdupenv_s(&buffer,&length,name) == 0)
+  {
+    if ((buffer != (wchar_t *) NULL) && (length > 0))
+    {
+      value=wstring(buffer);
+      free(buffer);
+      return(value);
+    }
+  }
+
+  return(value);
+#else
+  const char
+    *value;
+
+  value=getenv(wstringToString(name).c_str());
+  if (value == (const char *) NULL)
+    return(L"");
+
+  return(wstring(value,value+strlen(value)));
+#endif
+}
+
+bool Options::hasVisualStudioFolder(const wchar_t *name)
+{
+  wstring
+    path;
+
+  path=getEnvironmentVariable(L"ProgramW6432") + L"\\Microsoft Visual Studio\\" + name;
+  if (filesystem::exists(nativePath(path)))
+    return(true);
+  path=getEnvironmentVariable(L"ProgramFiles(x86)") + L"\\Microsoft Visual Studio\\" + name;
+  return(filesystem::exists(nativePath(path)) ? true : false);
+}
+
+void Options::setVisualStudioVersion()
+{
+  if (hasVisualStudioFolder(L"2022"))
+    _visualStudioVersion=VisualStudioVersion::VS2022;
+  else if (hasVisualStudioFolder(L"2019"))
+    _visualStudioVersion=VisualStudioVersion::VS2019;
+  else if (hasVisualStudioFolder(L"2017"))
+    _visualStudioVersion=VisualStudioVersion::VS2017;
+  else
+    _visualStudioVersion=VSLATEST;
+}
@@ -0,0 +1,202 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __Options__
+#define __Options__
+
+#include "Shared.h"
+
+class Options
+{
+public:
+  Options();
+
+  const wstring artifactsDirectory(const bool variantSensitive,const wstring &configuration) const;
+
+  const wstring binDirectory(const wstring &configuration) const;
+
+  const vector<wstring> binDirectories() const;
+
+  const wstring channelMaskDepth() const;
+
+  const wstring compileCommandsCompiler() const;
+  void compileCommandsCompiler(const wstring &value);
+
+  const vector<wstring> configurations() const;
+
+  const wstring criticalPathFile() const;
+  void criticalPathFile(const wstring &value);
+
+  bool enableDpc() const;
+  void enableDpc(bool value);
+
+  bool excludeAliases() const;
+  void excludeAliases(bool value);
+
+  bool excludeDeprecated() const;
+  void excludeDeprecated(bool value);
+
+  const vector<wstring> &formats() const;
+
+  bool includeIncompatibleLicense() const;
+  void includeIncompatibleLicense(bool value);
+
+  bool includeOptional() const;
+  void includeOptional(bool value);
+
+  bool installedSupport() const;
+  void installedSupport(bool value);
+
+  InstructionSet instructionSet() const;
+  void instructionSet(InstructionSet value);
+
+  const wstring instructionSetName() const;
+
+  bool isImageMagick7() const;
+
+  const wstring libraryCacheDirectory() const;
+  void libraryCacheDirectory(const wstring &value);
+
+  LinkTimeCodeGeneration linkTimeCodeGeneration() const;
+  void linkTimeCodeGeneration(LinkTimeCodeGeneration value);
+
+  const wstring machineName() const;
+
+  const wstring magickCoreProjectName() const;
+
+  const wstring ninjaCompiler() const;
+  void ninjaCompiler(const wstring &value);
+
+  Platform platform() const;
+  void platform(Platform value);
+
+  const wstring platformName() const;
+
+  const wstring platformAlias() const;
+
+  const wstring platformToolset() const;
+
+  PolicyConfig policyConfig() const;
+  void policyConfig(PolicyConfig value);
+
+  bool precompiledHeaders() const;
+  void precompiledHeaders(bool value);
+
+  bool profileGuidedOptimization() const;
+  void profileGuidedOptimization(bool value);
+
+  QuantumDepth quantumDepth() const;
+  void quantumDepth(QuantumDepth value);
+
+  const wstring quantumDepthBits() const;
+
+  bool reproducible() const;
+  void reproducible(bool value);
+
+  bool shareDependencies() const;
+  void shareDependencies(bool value);
+
+  const wstring sharedSolutionName() const;
+
+  const wstring solutionName() const;
+
+  bool solutionFilters() const;
+  void solutionFilters(bool value);
+
+  const vector<wstring> &solutionFilterProjects() const;
+
+  SolutionType solutionType() const;
+  void solutionType(SolutionType value);
+
+  int threadCount() const;
+  void threadCount(int value);
+
+  const wstring traceFile() const;
+  void traceFile(const wstring &value);
+
+  int unityBatchSize() const;
+  void unityBatchSize(int value);
+
+  bool useHDRI() const;
+  void useHDRI(bool value);
+
+  bool useOpenCL() const;
+  void useOpenCL(bool value);
+
+  bool useOpenMP() const;
+  void useOpenMP(bool value);
+
+  void updateProjectNames(wstring &value) const;
+
+  const wstring variantName() const;
+
+  VisualStudioVersion visualStudioVersion() const;
+  void visualStudioVersion(VisualStudioVersion value);
+
+  const wstring visualStudioVersionName() const;
+
+  bool zeroConfigurationSupport() const;
+  void zeroConfigurationSupport(bool value);
+
+  bool parseArgument(const wstring &argument);
+
+  void parseArguments(const wstring &arguments);
+
+private:
+  static wstring getEnvironmentVariable(const wchar_t *name);
+
+  static bool hasVisualStudioFolder(const wchar_t *name);
+
+  void setVisualStudioVersion();
+
+  Platform               _platform;
+  wstring                _compileCommandsCompiler;
+  wstring                _criticalPathFile;
+  bool                   _enableDpc;
+  bool                   _excludeAliases;
+  bool                   _excludeDeprecated;
+  vector<wstring>        _formats;
+  bool                   _includeIncompatibleLicense;
+  bool                   _includeOptional;
+  bool                   _installedSupport;
+  InstructionSet         _instructionSet;
+  bool                   _isImageMagick7;
+  wstring                _libraryCacheDirectory;
+  LinkTimeCodeGeneration _linkTimeCodeGeneration;
+  wstring                _ninjaCompiler;
+  PolicyConfig           _policyConfig;
+  bool                   _precompiledHeaders;
+  bool                   _profileGuidedOptimization;
+  QuantumDepth           _quantumDepth;
+  bool                   _reproducible;
+  bool                   _shareDependencies;
+  vector<wstring>        _solutionFilterProjects;
+  bool                   _solutionFilters;
+  SolutionType           _solutionType;
+  int                    _threadCount;
+  wstring                _traceFile;
+  int                    _unityBatchSize;
+  bool                   _useHDRI;
+  bool                   _useOpenCL;
+  bool                   _useOpenMP;
+  VisualStudioVersion    _visualStudioVersion;
+  bool                   _zeroConfigurationSupport;
+};
+
+#endif // __Options__
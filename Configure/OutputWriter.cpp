@@ -0,0 +1,130 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "OutputWriter.h"
+#include "Shared.h"
+
+OutputWriter::OutputWriter(const Trace &trace)
+  : _trace(trace)
+{
+  _changedCount=0;
+  _unchangedCount=0;
+}
+
+size_t OutputWriter::changedCount() const
+{
+  return(_changedCount);
+}
+
+void OutputWriter::copy(const wstring &source,const wstring &destination) const
+{
+  string
+    content;
+
+  if (!readFile(source,content))
+    throwException(L"Unable to open: " + source);
+
+  update(destination,content);
+}
+
+size_t OutputWriter::unchangedCount() const
+{
+  return(_unchangedCount);
+}
+
+void OutputWriter::write(const wstring &fileName,const wstring &content) const
+{
+  string
+    bytes;
+
+  // Same result as a wofstream that is opened in text mode on Windows, also on other platforms.
+  bytes.reserve(content.length()+content.length()/32);
+  for (auto& c : content)
+  {
+    if (c == L'\n')
+      bytes+='\r';
+    bytes+=(char) c;
+  }
+
+  update(fileName,bytes);
+}
+
+bool OutputWriter::readFile(const wstring &fileName,string &content)
+{
+  ifstream
+    file;
+
+  file.open(nativePath(fileName),ios::binary);
+  if (!file)
+    return(false);
+
+  content.assign(istreambuf_iterator<char>(file),istreambuf_iterator<char>());
+  return(true);
+}
+
+void OutputWriter::update(const wstring &fileName,const string &content) const
+{
+  error_code
+    error;
+
+  ofstream
+    file;
+
+  string
+    current;
+
+  wstring
+    tempFileName;
+
+  TraceEvent
+    event(_trace,L"output",L"Write file");
+
+  event.argument(L"file",fileName);
+  event.argument(L"bytes",content.length());
+
+  // Files that are not modified keep their timestamp so MSBuild will not rebuild them.
+  if ((filesystem::file_size(nativePath(fileName),error) == content.length()) && (readFile(fileName,current)) &&
+      (current == content))
+  {
+    event.argument(L"changed",(size_t) 0);
+    _unchangedCount++;
+    return;
+  }
+
+  tempFileName=fileName + L".tmp";
+  file.open(nativePath(tempFileName),ios::binary);
+  if (!file)
+    throwException(L"Unable to open: " + fileName);
+
+  file.write(content.data(),content.length());
+  file.close();
+  if (!file)
+    throwException(L"Unable to write: " + fileName);
+
+  filesystem::rename(nativePath(tempFileName),nativePath(fileName),error);
+  if (error)
+  {
+    filesystem::remove(nativePath(tempFileName),error);
+    throwException(L"Unable to replace: " + fileName);
+  }
+
+  event.argument(L"changed",(size_t) 1);
+  _changedCount++;
+}
@@ -0,0 +1,49 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __OutputWriter__
+#define __OutputWriter__
+
+#include "Trace.h"
+
+class OutputWriter
+{
+public:
+  OutputWriter(const Trace &trace);
+
+  size_t changedCount() const;
+
+  void copy(const wstring &source,const wstring &destination) const;
+
+  size_t unchangedCount() const;
+
+  void write(const wstring &fileName,const wstring &content) const;
+
+private:
+
+  static bool readFile(const wstring &fileName,string &content);
+
+  void update(const wstring &fileName,const string &content) const;
+
+  mutable atomic<size_t> _changedCount;
+  const Trace            &_trace;
+  mutable atomic<size_t> _unchangedCount;
+};
+
+#endif // __OutputWriter__
@@ -24,187 +24,50 @@ IMPLEMENT_DYNCREATE(TargetPage, CPropertyPage)
 
 TargetPage::TargetPage() : CPropertyPage(IDD_TARGET_PAGE)
 {
-  setVisualStudioVersion();
-
-#if _M_IX86
-  _platform=Platform::X86;
-#elif _M_ARM64
-  _platform=Platform::ARM64;
-#else
-  _platform=Platform::X64;
-#endif
-  _enableDpc=TRUE;
-  _excludeAliases=FALSE;
-  _excludeDeprecated=TRUE;
-#ifdef DEBUG
-  _includeIncompatibleLicense=TRUE;
-  _includeOptional=TRUE;
-#else
-  _includeIncompatibleLicense=FALSE;
-  _includeOptional=FALSE;
-#endif
-  _installedSupport=FALSE;
-  _policyConfig=PolicyConfig::OPEN;
-  _quantumDepth=QuantumDepth::Q16;
-  _solutionType=SolutionType::DYNAMIC_MT;
-  _useHDRI=FALSE;
-  _useOpenCL=TRUE;
-  _useOpenMP=TRUE;
-  _zeroConfigurationSupport=FALSE;
 }
 
 TargetPage::~TargetPage()
 {
 }
 
-bool TargetPage::enableDpc() const
-{
-  return(_enableDpc == TRUE);
-}
-
-void TargetPage::enableDpc(bool value)
-{
-  _enableDpc=value;
-}
-
-bool TargetPage::excludeAliases() const
-{
-  return(_excludeAliases == TRUE);
-}
-
-void TargetPage::excludeAliases(bool value)
-{
-  _excludeAliases=value;
-}
-
-bool TargetPage::excludeDeprecated() const
-{
-  return(_excludeDeprecated == TRUE);
-}
-
-void TargetPage::excludeDeprecated(bool value)
-{
-  _excludeDeprecated=value;
-}
-
-bool TargetPage::includeIncompatibleLicense() const
-{
-  return(_includeIncompatibleLicense == TRUE);
-}
-
-void TargetPage::includeIncompatibleLicense(bool value)
-{
-  _includeIncompatibleLicense=value;
-}
-
-bool TargetPage::includeOptional() const
-{
-  return(_includeOptional == TRUE);
-}
-
-void TargetPage::includeOptional(bool value)
-{
-  _includeOptional=value;
-}
-
-bool TargetPage::installedSupport() const
-{
-  return(_installedSupport == TRUE);
-}
-
-void TargetPage::installedSupport(bool value)
-{
-  _installedSupport=value;
-}
-
-Platform TargetPage::platform() const
-{
-  return(_platform);
-}
-
-void TargetPage::platform(Platform value)
-{
-  _platform=value;
-}
-
-PolicyConfig TargetPage::policyConfig() const
-{
-  return(_policyConfig);
-}
-
-void TargetPage::policyConfig(PolicyConfig value)
-{
-  _policyConfig=value;
-}
-
-QuantumDepth TargetPage::quantumDepth() const
-{
-  return(_quantumDepth);
-}
-
-void TargetPage::quantumDepth(QuantumDepth value)
-{
-  _quantumDepth=value;
-}
-
-SolutionType TargetPage::solutionType() const
-{
-  return(_solutionType);
-}
-
-void TargetPage::solutionType(SolutionType value)
-{
-  _solutionType=value;
-}
-
-bool TargetPage::useHDRI() const
-{
-  return(_useHDRI == TRUE);
-}
-
-void TargetPage::useHDRI(bool value)
-{
-  _useHDRI=value;
-}
-
-bool TargetPage::useOpenCL() const
-{
-  return(_useOpenCL == TRUE);
-}
-
-void TargetPage::useOpenCL(bool value)
-{
-  _useOpenCL=value;
-}
-
-bool TargetPage::useOpenMP() const
-{
-  return(_useOpenMP == TRUE);
-}
-
-void TargetPage::useOpenMP(bool value)
-{
-  _useOpenMP=value;
-}
-
-VisualStudioVersion TargetPage::visualStudioVersion() const
-{
-  return(_visualStudioVersion);
-}
-
-void TargetPage::visualStudioVersion(VisualStudioVersion value)
-{
-  _visualStudioVersion=value;
-}
-
-bool TargetPage::zeroConfigurationSupport() const
-{
-  return(_zeroConfigurationSupport != FALSE);
-}
-
-void TargetPage::zeroConfigurationSupport(bool value)
-{
-  _zeroConfigurationSupport=value;
+void TargetPage::load(const Options &options)
+{
+  _platform=options.platform();
+  _enableDpc=options.enableDpc();
+  _excludeAliases=options.excludeAliases();
+  _excludeDeprecated=options.excludeDeprecated();
+  _includeIncompatibleLicense=options.includeIncompatibleLicense();
+  _includeOptional=options.includeOptional();
+  _installedSupport=options.installedSupport();
+  _instructionSet=options.instructionSet();
+  _policyConfig=options.policyConfig();
+  _quantumDepth=options.quantumDepth();
+  _solutionType=options.solutionType();
+  _useHDRI=options.useHDRI();
+  _useOpenCL=options.useOpenCL();
+  _useOpenMP=options.useOpenMP();
+  _visualStudioVersion=options.visualStudioVersion();
+  _zeroConfigurationSupport=options.zeroConfigurationSupport();
+}
+
+void TargetPage::save(Options &options) const
+{
+  options.platform(_platform);
+  options.enableDpc(_enableDpc == TRUE);
+  options.excludeAliases(_excludeAliases == TRUE);
+  options.excludeDeprecated(_excludeDeprecated == TRUE);
+  options.includeIncompatibleLicense(_includeIncompatibleLicense == TRUE);
+  options.includeOptional(_includeOptional == TRUE);
+  options.installedSupport(_installedSupport == TRUE);
+  options.instructionSet(_instructionSet);
+  options.policyConfig(_policyConfig);
+  options.quantumDepth(_quantumDepth);
+  options.solutionType(_solutionType);
+  options.useHDRI(_useHDRI == TRUE);
+  options.useOpenCL(_useOpenCL == TRUE);
+  options.useOpenMP(_useOpenMP == TRUE);
+  options.visualStudioVersion(_visualStudioVersion);
+  options.zeroConfigurationSupport(_zeroConfigurationSupport != FALSE);
 }
 
 void TargetPage::DoDataExchange(CDataExchange* pDX)
@@ -215,6 +78,7 @@ void TargetPage::DoDataExchange(CDataExchange* pDX)
   DDX_CBIndex(pDX,IDC_PLATFORM,(int&) _platform);
   DDX_CBIndex(pDX,IDC_VISUALSTUDIO,(int&) _visualStudioVersion);
   DDX_CBIndex(pDX,IDC_POLICYCONFIG,(int&) _policyConfig);
+  DDX_CBIndex(pDX,IDC_INSTRUCTION_SET,(int&) _instructionSet);
   DDX_Radio(pDX,IDC_PROJECT_DYNAMIC_MT,(int&) _solutionType);
   DDX_Check(pDX,IDC_HDRI,_useHDRI);
   DDX_Check(pDX,IDC_OPEN_MP,_useOpenMP);
@@ -238,52 +102,3 @@ BOOL TargetPage::OnInitDialog()
 
 BEGIN_MESSAGE_MAP(TargetPage, CPropertyPage)
 END_MESSAGE_MAP()
-
-wstring TargetPage::getEnvironmentVariable(const wchar_t *name)
-{
-  wchar_t
-    *buffer;
-
-  size_t
-    length;
-
-  wstring
-    value;
-
-  if (_wdupenv_s(&buffer,&length,name) == 0)
-  {
-    if ((buffer != (wchar_t *) NULL) && (length > 0))
-    {
-      value=wstring(buffer);
-      free(buffer);
-      return(value);
-    }
-  }
-
-  return(value);
-}
-
-bool TargetPage::hasVisualStudioFolder(const wchar_t *name)
-{
-  wstring
-    path;
-
-  path=getEnvironmentVariable(L"ProgramW6432") + L"\\Microsoft Visual Studio\\" + name;
-  if (filesystem::exists(path))
-    return(true);
-  path=getEnvironmentVariable(L"ProgramFiles(x86)") + L"\\Microsoft Visual Studio\\" + name;
-  return(filesystem::exists(path) ? true : false);
-}
-
-void TargetPage::setVisualStudioVersion()
-{
-  if (hasVisualStudioFolder(L"2022"))
-    _visualStudioVersion=VisualStudioVersion::VS2022;
-  else if (hasVisualStudioFolder(L"2019"))
-    _visualStudioVersion=VisualStudioVersion::VS2019;
-  else if (hasVisualStudioFolder(L"2017"))
-    _visualStudioVersion=VisualStudioVersion::VS2017;
-  else
-    _visualStudioVersion=VSLATEST;
-}
-
@@ -20,7 +20,7 @@
 #ifndef __TargetPage__
 #define __TargetPage__
 
-#include "..\Shared.h"
+#include "..\Options.h"
 
 class TargetPage : public CPropertyPage
 {
@@ -32,50 +32,9 @@ public:
 
   ~TargetPage();
 
-  bool enableDpc() const;
-  void enableDpc(bool value);
+  void load(const Options &options);
 
-  bool excludeAliases() const;
-  void excludeAliases(bool value);
-
-  bool excludeDeprecated() const;
-  void excludeDeprecated(bool value);
-
-  bool includeIncompatibleLicense() const;
-  void includeIncompatibleLicense(bool value);
-
-  bool includeOptional() const;
-  void includeOptional(bool value);
-
-  bool installedSupport() const;
-  void installedSupport(bool value);
-
-  Platform platform() const;
-  void platform(Platform value);
-
-  PolicyConfig policyConfig() const;
-  void policyConfig(PolicyConfig value);
-
-  QuantumDepth quantumDepth() const;
-  void quantumDepth(QuantumDepth value);
-
-  SolutionType solutionType() const;
-  void solutionType(SolutionType value);
-
-  bool useHDRI() const;
-  void useHDRI(bool value);
-
-  bool useOpenCL() const;
-  void useOpenCL(bool value);
-
-  bool useOpenMP() const;
-  void useOpenMP(bool value);
-
-  VisualStudioVersion visualStudioVersion() const;
-  void visualStudioVersion(VisualStudioVersion value);
-
-  bool zeroConfigurationSupport() const;
-  void zeroConfigurationSupport(bool value);
+  void save(Options &options) const;
 
 protected:
 
@@ -87,12 +46,6 @@ protected:
 
 private:
 
-  wstring getEnvironmentVariable(const wchar_t *name);
-
-  bool hasVisualStudioFolder(const wchar_t *name);
-
-  void setVisualStudioVersion();
-
   Platform            _platform;
   BOOL                _enableDpc;
   BOOL                _excludeAliases;
@@ -100,6 +53,7 @@ private:
   BOOL                _includeIncompatibleLicense;
   BOOL                _includeOptional;
   BOOL                _installedSupport;
+  InstructionSet      _instructionSet;
   PolicyConfig        _policyConfig;
   QuantumDepth        _quantumDepth;
   SolutionType        _solutionType;
@@ -22,7 +22,7 @@
 
 Compiler Project::compiler() const
 {
-  return(_magickProject && _wizard.visualStudioVersion() >= VisualStudioVersion::VS2022
+  return(_magickProject && _options.visualStudioVersion() >= VisualStudioVersion::VS2022
     ? Compiler::CPP
     : Compiler::Default);
 }
@@ -57,9 +57,19 @@ const vector<wstring> &Project::directories()
   return(_directories);
 }
 
-const vector<wstring> &Project::excludes()
+ConfigCache &Project::configCache() const
 {
-  return(_excludes);
+  return(_configCache);
+}
+
+DirectoryIndex &Project::directoryIndex() const
+{
+  return(_directoryIndex);
+}
+
+const FileMatcher &Project::excludes() const
+{
+  return(_excludesMatcher);
 }
 
 const vector<ProjectFile*> &Project::files() const
@@ -77,13 +87,13 @@ const vector<wstring> &Project::includesNasm()
   return(_includesNasm);
 }
 
-const vector<wstring> &Project::platformExcludes(Platform platform)
+const FileMatcher &Project::platformExcludes(Platform platform) const
 {
   switch (platform)
   {
-    case Platform::X86: return(_excludesX86);
-    case Platform::X64: return(_excludesX64);
-    case Platform::ARM64: return(_excludesARM64);
+    case Platform::X86: return(_excludesMatcherX86);
+    case Platform::X64: return(_excludesMatcherX64);
+    case Platform::ARM64: return(_excludesMatcherARM64);
     default: throw;
   }
 }
@@ -109,6 +119,11 @@ const wstring Project::filePath(const wstring &subPath) const
   return(path + L"\\" + subPath);
 }
 
+bool Project::isCoder() const
+{
+  return(_modulePrefix == L"IM_MOD");
+}
+
 bool Project::isConsole() const
 {
   if (!isExe())
@@ -121,11 +136,24 @@ bool Project::isDll() const
   return((_type == ProjectType::DLLTYPE) || (_type == ProjectType::DLLMODULETYPE));
 }
 
+bool Project::isDependency() const
+{
+  return(_filesFolder != L"ImageMagick");
+}
+
 bool Project::isExe() const
 {
   return((_type == ProjectType::EXETYPE) || (_type == ProjectType::EXEMODULETYPE) || (_type == ProjectType::APPTYPE));
 }
 
+bool Project::isFormatExcluded(const wstring &name) const
+{
+  if (!isCoder() || _options.formats().empty())
+    return(false);
+
+  return(!contains(_options.formats(),toLower(name)));
+}
+
 bool Project::isFuzz() const
 {
   return(_modulePrefix == L"FUZZ");
@@ -141,6 +169,16 @@ bool Project::isModule() const
   return((_type == ProjectType::DLLMODULETYPE) || (_type == ProjectType::EXEMODULETYPE));
 }
 
+bool Project::isInstructionSetDisabled() const
+{
+  return(_disableInstructionSet);
+}
+
+bool Project::isLinkTimeCodeGenerationDisabled() const
+{
+  return(_disableLinkTimeCodeGeneration);
+}
+
 bool Project::isOptimizationDisable() const
 {
   return(_disableOptimization);
@@ -151,6 +189,12 @@ bool Project::isSupported(const VisualStudioVersion visualStudioVersion) const
   return(visualStudioVersion >= _minimumVisualStudioVersion);
 }
 
+bool Project::isVariantSensitive() const
+{
+  // Only the ImageMagick projects are compiled with the quantum depth and HDRI settings of magick-baseconfig.h.
+  return(!isDependency());
+}
+
 const vector<wstring> &Project::libraries()
 {
   return(_libraries);
@@ -171,14 +215,47 @@ const wstring Project::notice() const
   return(_notice);
 }
 
+const OptimizationProfile &Project::optimizationProfile() const
+{
+  return(_optimizationProfile);
+}
+
+const wstring Project::precompiledHeader() const
+{
+  return(_precompiledHeader);
+}
+
+const FileMatcher &Project::precompiledHeaderExcludes() const
+{
+  return(_precompiledHeaderExcludesMatcher);
+}
+
 const vector<wstring> &Project::references()
 {
   return(_references);
 }
 
+const Trace &Project::trace() const
+{
+  return(_trace);
+}
+
 bool Project::treatWarningAsError() const
 {
-  return(_magickProject && _wizard.isImageMagick7());
+  return(_magickProject && _options.isImageMagick7());
+}
+
+int Project::unityBatchSize() const
+{
+  if ((_options.unityBatchSize() < 2) || (_unityBatchSize < 0))
+    return(_options.unityBatchSize());
+
+  return(_unityBatchSize);
+}
+
+const FileMatcher &Project::unityExcludes() const
+{
+  return(_unityExcludesMatcher);
 }
 
 bool Project::useNasm() const
@@ -203,7 +280,7 @@ const wstring Project::version() const
 
 int Project::warningLevel() const
 {
-  return(_magickProject && _wizard.isImageMagick7() ? 4 : 0);
+  return(_magickProject && _options.isImageMagick7() ? 4 : 0);
 }
 
 void Project::checkFiles(const VisualStudioVersion visualStudioVersion)
@@ -214,6 +291,11 @@ void Project::checkFiles(const VisualStudioVersion visualStudioVersion)
   auto filter=[visualStudioVersion](ProjectFile* p){ return p->isSupported(visualStudioVersion); };
   auto it=std::copy_if(_files.begin(),_files.end(),newFiles.begin(),filter);
   newFiles.resize(std::distance(newFiles.begin(),it));
+  for (auto& file : _files)
+  {
+    if (!filter(file))
+      delete file;
+  }
   _files=newFiles;
 }
 
@@ -222,45 +304,96 @@ void Project::mergeProjectFiles()
   ProjectFile
     *projectFile;
 
-  if ((_type != ProjectType::DLLMODULETYPE) || (_wizard.solutionType() == SolutionType::DYNAMIC_MT))
+  if ((_type != ProjectType::DLLMODULETYPE) || (_options.solutionType() == SolutionType::DYNAMIC_MT))
     return;
 
-  projectFile=new ProjectFile(&_wizard,this,L"CORE",_name);
+  projectFile=new ProjectFile(&_options,this,L"CORE",_name);
   for (auto& file : _files)
   {
     projectFile->merge(file);
+    delete file;
   }
   _files.clear();
   _files.push_back(projectFile);
 }
 
-Project* Project::create(const ConfigureWizard &wizard,const wstring &configFolder, const wstring &filesFolder, const wstring &name)
+void Project::removeFiles(const unordered_set<const ProjectFile*> &keep)
+{
+  std::vector<ProjectFile*>
+    newFiles;
+
+  for (auto& file : _files)
+  {
+    if (keep.find(file) != keep.end())
+      newFiles.push_back(file);
+    else
+      delete file;
+  }
+  _files=newFiles;
+}
+
+Project* Project::create(const Options &options,DirectoryIndex &directoryIndex,ConfigCache &configCache,const Trace &trace,const wstring &configFolder, const wstring &filesFolder, const wstring &name)
 {
+  ConfigCacheRecord
+    record;
+
   wifstream
     config;
 
   wstring
     configPath;
 
-  configPath=configFolder + L"\\" + name + L"\\.ImageMagick";
-  config.open(pathFromRoot(configPath + L"\\Config.txt"));
-  if (!config)
+  Project
+    *project;
+
+  TraceEvent
+    event(trace,L"config",L"Load project config");
+
+  event.argument(L"project",name);
+  if (configCache.get(pathFromRoot(configFolder + L"\\" + name),record))
   {
-    configPath=configFolder + L"\\" + name;
-    config.open(pathFromRoot(configPath +L"\\Config.txt"));
+    event.argument(L"cached",(size_t) 1);
+    record.value(configPath);
+    project=new Project(options,directoryIndex,configCache,trace,configPath,filesFolder,name);
+    project->cache(record);
+    project->compileConfig();
+
+    if (project->_onlyImageMagick7 && !options.isImageMagick7())
+      return((Project *) NULL);
+
+    return(project);
   }
 
+  configPath=configFolder + L"\\" + name + L"\\.ImageMagick";
+  record.addFile(pathFromRoot(configPath + L"\\Config.txt"));
+  if (!directoryIndex.fileExists(pathFromRoot(configPath + L"\\Config.txt")))
+    {
+      configPath=configFolder + L"\\" + name;
+      record.addFile(pathFromRoot(configPath + L"\\Config.txt"));
+    }
+
+  if (!directoryIndex.fileExists(pathFromRoot(configPath + L"\\Config.txt")))
+    return((Project *) NULL);
+
+  event.argument(L"cached",(size_t) 0);
+  config.open(nativePath(pathFromRoot(configPath + L"\\Config.txt")));
   if (!config)
     return((Project *) NULL);
 
-  Project* project = new Project(wizard,configPath,filesFolder,name);
+  project=new Project(options,directoryIndex,configCache,trace,configPath,filesFolder,name);
   project->loadConfig(config);
   config.close();
 
-  if (project->_onlyImageMagick7 && !wizard.isImageMagick7())
+  project->compileConfig();
+
+  if (project->_onlyImageMagick7 && !options.isImageMagick7())
     return((Project *) NULL);
 
-  project->setNoticeAndVersion();
+  project->setNoticeAndVersion(record);
+
+  record.value(configPath);
+  project->cache(record);
+  configCache.set(pathFromRoot(configFolder + L"\\" + name),record);
 
   return(project);
 }
@@ -270,6 +403,9 @@ bool Project::loadFiles()
   ProjectFile
     *projectFile;
 
+  // The files of a previous solution are dropped because they depend on the options of that solution.
+  for (auto& file : _files)
+    delete file;
   _files.clear();
 
   if (shouldSkip())
@@ -284,14 +420,14 @@ bool Project::loadFiles()
     }
     case ProjectType::DLLTYPE:
     {
-      projectFile=new ProjectFile(&_wizard,this,L"CORE",_name);
+      projectFile=new ProjectFile(&_options,this,L"CORE",_name);
       _files.push_back(projectFile);
       break;
     }
     case ProjectType::APPTYPE:
     case ProjectType::EXETYPE:
     {
-      projectFile=new ProjectFile(&_wizard,this,L"UTIL",_name);
+      projectFile=new ProjectFile(&_options,this,L"UTIL",_name);
       _files.push_back(projectFile);
       break;
     }
@@ -302,7 +438,7 @@ bool Project::loadFiles()
     }
     case ProjectType::STATICTYPE:
     {
-      projectFile=new ProjectFile(&_wizard,this,L"CORE",_name);
+      projectFile=new ProjectFile(&_options,this,L"CORE",_name);
       _files.push_back(projectFile);
       break;
     }
@@ -313,13 +449,13 @@ bool Project::loadFiles()
 
 bool Project::shouldSkip() const
 {
-  if (_disabledARM64 && _wizard.platform() == Platform::ARM64)
+  if (_disabledARM64 && _options.platform() == Platform::ARM64)
     return(true);
 
-  if (_hasIncompatibleLicense && !_wizard.includeIncompatibleLicense())
+  if (_hasIncompatibleLicense && !_options.includeIncompatibleLicense())
     return(true);
 
-  if (_isOptional && !_wizard.includeOptional())
+  if (_isOptional && !_options.includeOptional())
     return(true);
 
   return(false);
@@ -327,7 +463,8 @@ bool Project::shouldSkip() const
 
 void Project::updateProjectNames()
 {
-  _wizard.updateProjectNames(_name);
+  _options.updateProjectNames(_name);
+  _options.updateProjectNames(_precompiledHeader);
 
   updateProjectNames(_dependencies);
   updateProjectNames(_directories);
@@ -338,17 +475,22 @@ void Project::updateProjectNames()
 void Project::updateProjectNames(vector<wstring> &vector)
 {
   for (auto& value : vector)
-    _wizard.updateProjectNames(value);
+    _options.updateProjectNames(value);
 }
 
-Project::Project(const ConfigureWizard &wizard,const wstring &configFolder,const wstring &filesFolder,const wstring &name)
-  : _wizard(wizard)
+Project::Project(const Options &options,DirectoryIndex &directoryIndex,ConfigCache &configCache,const Trace &trace,const wstring &configFolder,const wstring &filesFolder,const wstring &name)
+  : _configCache(configCache),
+    _directoryIndex(directoryIndex),
+    _options(options),
+    _trace(trace)
 {
   _configFolder=configFolder;
   _filesFolder=filesFolder;
   _name=name;
 
   _disabledARM64=false;
+  _disableInstructionSet=false;
+  _disableLinkTimeCodeGeneration=false;
   _disableOptimization=false;
   _hasIncompatibleLicense=false;
   _isOptional=false;
@@ -356,6 +498,7 @@ Project::Project(const ConfigureWizard &wizard,const wstring &configFolder,const
   _minimumVisualStudioVersion=VSEARLIEST;
   _onlyImageMagick7=false;
   _type=ProjectType::UNDEFINEDTYPE;
+  _unityBatchSize=-1;
   _useNasm=false;
   _useOpenCL=false;
   _useUnicode=false;
@@ -391,6 +534,69 @@ void Project::addLines(wifstream &config,vector<wstring> &container)
   }
 }
 
+void Project::cache(ConfigCacheRecord &record)
+{
+  int
+    minimumVisualStudioVersion,
+    type;
+
+  minimumVisualStudioVersion=(int) _minimumVisualStudioVersion;
+  type=(int) _type;
+
+  record.value(_configDefine);
+  record.value(_defines);
+  record.value(_definesDll);
+  record.value(_definesLib);
+  record.value(_dependencies);
+  record.value(_directories);
+  record.value(_disabledARM64);
+  record.value(_disableInstructionSet);
+  record.value(_disableLinkTimeCodeGeneration);
+  record.value(_disableOptimization);
+  record.value(_excludes);
+  record.value(_excludesX86);
+  record.value(_excludesX64);
+  record.value(_excludesARM64);
+  record.value(_hasIncompatibleLicense);
+  record.value(_includes);
+  record.value(_includesNasm);
+  record.value(_isOptional);
+  record.value(_libraries);
+  record.value(_licenseFileNames);
+  record.value(_magickProject);
+  record.value(minimumVisualStudioVersion);
+  record.value(_moduleDefinitionFile);
+  record.value(_modulePrefix);
+  record.value(_notice);
+  record.value(_onlyImageMagick7);
+  record.value(_optimization);
+  record.value(_path);
+  record.value(_precompiledHeader);
+  record.value(_precompiledHeaderExcludes);
+  record.value(_references);
+  record.value(type);
+  record.value(_unityBatchSize);
+  record.value(_unityExcludes);
+  record.value(_useNasm);
+  record.value(_useOpenCL);
+  record.value(_useUnicode);
+  record.value(_versions);
+
+  _minimumVisualStudioVersion=(VisualStudioVersion) minimumVisualStudioVersion;
+  _type=(ProjectType) type;
+}
+
+void Project::compileConfig()
+{
+  _excludesMatcher=FileMatcher(_excludes);
+  _excludesMatcherX86=FileMatcher(_excludesX86);
+  _excludesMatcherX64=FileMatcher(_excludesX64);
+  _excludesMatcherARM64=FileMatcher(_excludesARM64);
+  _precompiledHeaderExcludesMatcher=FileMatcher(_precompiledHeaderExcludes);
+  _unityExcludesMatcher=FileMatcher(_unityExcludes);
+  _optimizationProfile=OptimizationProfile(_name,_optimization);
+}
+
 void Project::loadConfig(wifstream &config)
 {
   wstring
@@ -415,6 +621,10 @@ void Project::loadConfig(wifstream &config)
       addLines(config,_directories);
     else if (line == L"[DISABLED_ARM64]")
       _disabledARM64=true;
+    else if (line == L"[DISABLE_INSTRUCTION_SET]")
+      _disableInstructionSet=true;
+    else if (line == L"[DISABLE_LTCG]")
+      _disableLinkTimeCodeGeneration=true;
     else if (line == L"[DISABLE_OPTIMIZATION]")
       _disableOptimization=true;
     else if (line == L"[DLL]")
@@ -451,12 +661,23 @@ void Project::loadConfig(wifstream &config)
       _useNasm=true;
     else if (line == L"[ONLY_IMAGEMAGICK7]")
       _onlyImageMagick7=true;
+    else if (line == L"[OPTIMIZATION]")
+      addLines(config,_optimization);
     else if (line == L"[OPTIONAL]")
       _isOptional=true;
     else if (line == L"[PATH]")
       _path=readLine(config);
+    else if (line == L"[PRECOMPILED_HEADER]")
+    {
+      _precompiledHeader=readLine(config);
+      addLines(config,_precompiledHeaderExcludes);
+    }
     else if (line == L"[REFERENCES]")
       addLines(config,_references);
+    else if (line == L"[UNITY_BATCH_SIZE]")
+      _unityBatchSize=(int) wcstol(readLine(config).c_str(),NULL,10);
+    else if (line == L"[UNITY_EXCLUDES]")
+      addLines(config,_unityExcludes);
     else if (line == L"[UNICODE]")
       _useUnicode=true;
     else if (line == L"[OPENCL]")
@@ -481,34 +702,47 @@ void Project::loadModules()
     const wstring
       path(pathFromRoot(filePath(dir)));
 
-    if (!directoryExists(path))
+    if (!_directoryIndex.directoryExists(path))
       throwException(L"Invalid folder specified: " + path);
-    
-    for (const auto& entry : filesystem::directory_iterator(path))
+
+    for (const auto& entry : _directoryIndex.entries(path))
     {
       wstring
         fileName,
         name;
 
-      if (!entry.is_regular_file())
+      if (!entry.isRegularFile())
         continue;
 
-      fileName=entry.path().filename();
-      if (contains(_excludes,fileName) || startsWith(fileName,L"main.") || !isValidSrcFile(fileName))
+      fileName=entry.name();
+      if (_excludesMatcher.matches(fileName) || startsWith(fileName,L"main.") || !isValidSrcFile(fileName))
         continue;
 
       name=fileName;
       name=name.substr(0,name.find_last_of(L"."));
-      projectFile=new ProjectFile(&_wizard,this,_modulePrefix,name);
+      if (isFormatExcluded(name))
+        continue;
+
+      projectFile=new ProjectFile(&_options,this,_modulePrefix,name);
       _files.push_back(projectFile);
 
       for (auto& alias : projectFile->aliases())
       {
-        projectAlias=new ProjectFile(&_wizard,this,_modulePrefix,alias,name);
+        projectAlias=new ProjectFile(&_options,this,_modulePrefix,alias,name);
         _files.push_back(projectAlias);
       }
     }
   }
+
+  if (!isCoder())
+    return;
+
+  for (auto& format : _options.formats())
+  {
+    auto matches=[&format](ProjectFile* p){ return(toLower(p->moduleName()) == format); };
+    if (std::find_if(_files.begin(),_files.end(),matches) == _files.end())
+      throwException(L"Unknown format specified: " + format);
+  }
 }
 
 const vector<wstring> Project::readLicenseFilenames(const wstring &line) const
@@ -525,28 +759,24 @@ const vector<wstring> Project::readLicenseFilenames(const wstring &line) const
   while(getline(wss, fileName, L';'))
   {
     wstring
-      filePath(pathFromRoot(filePath(fileName)));
-
-    filesystem::path
-      file(filePath);
+      licenseFileName(pathFromRoot(filePath(fileName)));
 
-    if (!filesystem::exists(file))
+    if (!_directoryIndex.fileExists(licenseFileName))
       throwException(L"Unable to open license file: " + fileName);
 
-    fileNames.push_back(filePath);
+    fileNames.push_back(licenseFileName);
   }
 
   return (fileNames);
 }
 
-void Project::setNoticeAndVersion()
+void Project::setNoticeAndVersion(ConfigCacheRecord &record)
 {
   _notice=L"";
   for (auto& licenseFileName : _licenseFileNames)
   {
     filesystem::path
-      folder,
-      versionFile;
+      folder;
 
     wifstream
       version;
@@ -554,19 +784,20 @@ void Project::setNoticeAndVersion()
     wstring
       versionFileName;
 
-    folder=filesystem::path(licenseFileName).parent_path();
+    record.addFile(licenseFileName);
+    folder=nativePath(licenseFileName).parent_path();
     versionFileName=folder.wstring()+L"\\.ImageMagick\\ImageMagick.version.h";
-    versionFile=filesystem::path(versionFileName).wstring();
-    if (!filesystem::exists(versionFile))
+    record.addFile(versionFileName);
+    if (!_directoryIndex.fileExists(versionFileName))
       {
         folder=folder.parent_path();
         versionFileName=folder.wstring()+L"\\.ImageMagick\\ImageMagick.version.h";
-        versionFile=filesystem::path(versionFileName).wstring();
-        if (!filesystem::exists(versionFile))
+        record.addFile(versionFileName);
+        if (!_directoryIndex.fileExists(versionFileName))
           throwException(L"Unable to find version file for: " + _name);
       }
 
-    version.open(versionFileName);
+    version.open(nativePath(versionFileName));
     while (!version.eof())
     {
       wstring
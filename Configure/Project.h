@@ -20,15 +20,23 @@
 #ifndef __Project__
 #define __Project__
 
-#include "ConfigureWizard.h"
+#include "ConfigCache.h"
+#include "DirectoryIndex.h"
+#include "FileMatcher.h"
+#include "OptimizationProfile.h"
+#include "Options.h"
 #include "ProjectFile.h"
 #include "Shared.h"
+#include "Trace.h"
+#include <unordered_set>
 
 class Project
 {
 public:
   Compiler compiler() const;
 
+  ConfigCache &configCache() const;
+
   const wstring configDefine() const;
 
   const vector<wstring> &defines();
@@ -41,7 +49,9 @@ public:
 
   const vector<wstring> &directories();
 
-  const vector<wstring> &excludes();
+  DirectoryIndex &directoryIndex() const;
+
+  const FileMatcher &excludes() const;
 
   const vector<ProjectFile*> &files() const;
 
@@ -49,28 +59,40 @@ public:
 
   const vector<wstring> &includesNasm();
 
-  const vector<wstring> &platformExcludes(Platform platform);
+  const FileMatcher &platformExcludes(Platform platform) const;
 
   const wstring configPath(const wstring &subPath) const;
 
   const wstring filePath(const wstring &subPath) const;
 
+  bool isCoder() const;
+
   bool isConsole() const;
 
   bool isDll() const;
 
+  bool isDependency() const;
+
   bool isExe() const;
 
+  bool isFormatExcluded(const wstring &name) const;
+
   bool isFuzz() const;
 
   bool isLib() const;
 
   bool isModule() const;
 
+  bool isInstructionSetDisabled() const;
+
+  bool isLinkTimeCodeGenerationDisabled() const;
+
   bool isOptimizationDisable() const;
 
   bool isSupported(const VisualStudioVersion visualStudioVersion) const;
 
+  bool isVariantSensitive() const;
+
   const vector<wstring> &libraries();
 
   const wstring moduleDefinitionFile() const;
@@ -79,10 +101,22 @@ public:
 
   const wstring notice() const;
 
+  const OptimizationProfile &optimizationProfile() const;
+
+  const wstring precompiledHeader() const;
+
+  const FileMatcher &precompiledHeaderExcludes() const;
+
   const vector<wstring> &references();
 
+  const Trace &trace() const;
+
   bool treatWarningAsError() const;
 
+  int unityBatchSize() const;
+
+  const FileMatcher &unityExcludes() const;
+
   bool useNasm() const;
 
   bool useOpenCL() const;
@@ -95,12 +129,14 @@ public:
 
   void checkFiles(const VisualStudioVersion visualStudioVersion);
 
-  static Project* create(const ConfigureWizard &wizard,const wstring &configFolder,const wstring &filesFolder,const wstring& name);
+  static Project* create(const Options &options,DirectoryIndex &directoryIndex,ConfigCache &configCache,const Trace &trace,const wstring &configFolder,const wstring &filesFolder,const wstring& name);
 
   bool loadFiles();
 
   void mergeProjectFiles();
 
+  void removeFiles(const unordered_set<const ProjectFile*> &keep);
+
   bool shouldSkip() const;
 
   void updateProjectNames();
@@ -108,20 +144,25 @@ public:
   void updateProjectNames(vector<wstring> &vector);
 
 private:
-  Project(const ConfigureWizard &wizard,const wstring &configFolder,const wstring &filesFolder,const wstring &name);
+  Project(const Options &options,DirectoryIndex &directoryIndex,ConfigCache &configCache,const Trace &trace,const wstring &configFolder,const wstring &filesFolder,const wstring &name);
 
   void addLines(wifstream &config,wstring &value);
 
   void addLines(wifstream &config,vector<wstring> &container);
 
+  void cache(ConfigCacheRecord &record);
+
+  void compileConfig();
+
   void loadConfig(wifstream &config);
 
   void loadModules();
 
   const vector<wstring> readLicenseFilenames(const wstring &line) const;
 
-  void setNoticeAndVersion();
+  void setNoticeAndVersion(ConfigCacheRecord &record);
 
+  ConfigCache           &_configCache;
   wstring               _configDefine;
   wstring               _configFolder;
   vector<wstring>       _defines;
@@ -129,12 +170,19 @@ private:
   vector<wstring>       _definesLib;
   vector<wstring>       _dependencies;
   vector<wstring>       _directories;
+  DirectoryIndex        &_directoryIndex;
   bool                  _disabledARM64;
+  bool                  _disableInstructionSet;
+  bool                  _disableLinkTimeCodeGeneration;
   bool                  _disableOptimization;
   vector<wstring>       _excludes;
   vector<wstring>       _excludesX86;
   vector<wstring>       _excludesX64;
   vector<wstring>       _excludesARM64;
+  FileMatcher           _excludesMatcher;
+  FileMatcher           _excludesMatcherX86;
+  FileMatcher           _excludesMatcherX64;
+  FileMatcher           _excludesMatcherARM64;
   vector<ProjectFile*>  _files;
   wstring               _filesFolder;
   bool                  _hasIncompatibleLicense;
@@ -150,14 +198,23 @@ private:
   wstring               _name;
   wstring               _notice;
   bool                  _onlyImageMagick7;
+  vector<wstring>       _optimization;
+  OptimizationProfile   _optimizationProfile;
+  const Options         &_options;
   wstring               _path;
+  wstring               _precompiledHeader;
+  vector<wstring>       _precompiledHeaderExcludes;
+  FileMatcher           _precompiledHeaderExcludesMatcher;
   vector<wstring>       _references;
+  const Trace           &_trace;
   ProjectType           _type;
+  int                   _unityBatchSize;
+  vector<wstring>       _unityExcludes;
+  FileMatcher           _unityExcludesMatcher;
   bool                  _useNasm;
   bool                  _useOpenCL;
   bool                  _useUnicode;
   vector<wstring>       _versions;
-  const ConfigureWizard &_wizard;
 };
 
 #endif // __Project__
@@ -18,42 +18,64 @@
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 */
 #include "stdafx.h"
+#include "DependencyGraph.h"
+#include "NinjaFile.h"
 #include "Project.h"
 #include "ProjectFile.h"
+#include "PropertySheet.h"
 #include "Shared.h"
 #include <algorithm>
 #include <map>
 
 static const wstring
+  libraryCacheInputsFileName(L"LibraryCache.inputs"),
   rootPath(L"..\\..\\");
 
-ProjectFile::ProjectFile(const ConfigureWizard *wizard,Project *project,
+static inline const wstring fromRoot(const wstring &path)
+{
+  return(startsWith(path,rootPath) ? path.substr(rootPath.length()) : path);
+}
+
+static inline const wstring quoteArgument(const wstring &value)
+{
+  if (value.find_first_of(L" \"") == wstring::npos)
+    return(value);
+
+  return(L"\"" + replace(value,L"\"",L"\\\"") + L"\"");
+}
+
+ProjectFile::ProjectFile(const Options *options,Project *project,
   const wstring &prefix,const wstring &name)
-  : _wizard(wizard),
-    _project(project),
+  : _name(name),
+    _options(options),
     _prefix(prefix),
-    _name(name)
+    _project(project)
 {
   initialize(project);
 
-  if (!wizard->excludeAliases())
+  if (!options->excludeAliases())
     loadAliases();
 }
 
-ProjectFile::ProjectFile(const ConfigureWizard *wizard,Project *project,
+ProjectFile::ProjectFile(const Options *options,Project *project,
   const wstring &prefix,const wstring &name,const wstring &reference)
-  : _wizard(wizard),
-    _project(project),
+  : _name(name),
+    _options(options),
     _prefix(prefix),
-    _name(name),
+    _project(project),
     _reference(reference)
 {
   initialize(project);
 }
 
-const wstring ProjectFile::binDirectory() const
+const wstring ProjectFile::artifactsDirectory(const wstring &configuration) const
+{
+  return(rootPath + _options->artifactsDirectory(_project->isVariantSensitive(),configuration));
+}
+
+const wstring ProjectFile::binDirectory(const wstring &configuration) const
 {
-    return(rootPath + _wizard->binDirectory());
+    return(artifactsDirectory(configuration) + L"bin\\");
 }
 
 const vector<wstring> &ProjectFile::dependencies() const
@@ -71,11 +93,39 @@ const wstring ProjectFile::guid() const
   return(_guid);
 }
 
+const vector<wstring> &ProjectFile::includes() const
+{
+  return(_includes);
+}
+
+const wstring ProjectFile::libraryName() const
+{
+  return(getTargetName(false) + L".lib");
+}
+
+const wstring ProjectFile::moduleName() const
+{
+  return(_name);
+}
+
 const wstring ProjectFile::name() const
 {
   return(_prefix+L"_"+_name);
 }
 
+const wstring ProjectFile::ninjaTarget() const
+{
+  if (_project->isExe())
+    return(fromRoot(outputDirectory(L"Release")) + _name + L".exe");
+
+  return(fromRoot(outputDirectory(L"Release")) + getTargetName(false) + (isLib() ? L".lib" : L".dll"));
+}
+
+const wstring ProjectFile::projectDirectory() const
+{
+  return((_project->isVariantSensitive() ? _options->solutionName() : _options->sharedSolutionName()) + L".Projects\\" + name());
+}
+
 const vector<wstring> &ProjectFile::aliases() const
 {
   return(_aliases);
@@ -83,6 +133,7 @@ const vector<wstring> &ProjectFile::aliases() const
 
 void ProjectFile::initialize(Project* project)
 {
+  _libraryCached=false;
   _minimumVisualStudioVersion=VSEARLIEST;
   setFileName();
   _guid=createGuid(name());
@@ -113,20 +164,32 @@ bool ProjectFile::isSrcFile(const wstring &fileName)
 
 bool ProjectFile::isExcluded(const wstring &fileName)
 {
-  if (contains(_project->excludes(),fileName))
+  wstring
+    name;
+
+  if (_project->excludes().matches(fileName))
     return true;
 
-  if (contains(_project->platformExcludes(_wizard->platform()),fileName))
+  if (_project->platformExcludes(_options->platform()).matches(fileName))
+    return true;
+
+  if (isValidSrcFile(fileName) && _project->isFormatExcluded(fileName.substr(0,fileName.find_last_of(L"."))))
     return true;
 
   if (endsWith(fileName,L".h"))
-    return isExcluded(replace(fileName,L".h",L".c")) || isExcluded(replace(fileName,L".h",L".cc"));
+  {
+    name=fileName.substr(0,fileName.length()-2);
+    return isExcluded(name+L".c") || isExcluded(name+L".cc");
+  }
 
   return false;
 }
 
 void ProjectFile::loadAliases()
 {
+  ConfigCacheRecord
+    record;
+
   wifstream
     aliases;
 
@@ -139,18 +202,32 @@ void ProjectFile::loadAliases()
 
   fileName=pathFromRoot(_project->configPath(L"Aliases." + _name + L".txt"));
 
-  aliases.open(fileName);
-  if (!aliases)
-    return;
-
-  while (!aliases.eof())
+  if (!_project->configCache().get(fileName,record))
   {
-    line=readLine(aliases);
-    if (!line.empty())
-      _aliases.push_back(line);
+    TraceEvent
+      event(_project->trace(),L"config",L"Parse aliases");
+
+    event.argument(L"file",fileName);
+    record.addFile(fileName);
+
+    aliases.open(nativePath(fileName));
+    if (aliases)
+    {
+      while (!aliases.eof())
+      {
+        line=readLine(aliases);
+        if (!line.empty())
+          _aliases.push_back(line);
+      }
+
+      aliases.close();
+    }
   }
 
-  aliases.close();
+  record.value(_aliases);
+
+  if (!record.isLoading())
+    _project->configCache().set(fileName,record);
 }
 
 bool ProjectFile::isSupported(const VisualStudioVersion visualStudioVersion) const
@@ -158,8 +235,27 @@ bool ProjectFile::isSupported(const VisualStudioVersion visualStudioVersion) con
   return(visualStudioVersion >= _minimumVisualStudioVersion);
 }
 
+void ProjectFile::libraryCache(const wstring &directory,const bool cached,const wstring &inputs)
+{
+  _libraryCacheDirectory=directory;
+  _libraryCached=cached;
+  _libraryCacheInputs=inputs;
+}
+
 void ProjectFile::loadConfig()
 {
+  ConfigCacheRecord
+    record;
+
+  int
+    minimumVisualStudioVersion;
+
+  vector<wstring>
+    cppFiles,
+    definesLib,
+    dependencies,
+    includes;
+
   wifstream
     config;
 
@@ -171,27 +267,53 @@ void ProjectFile::loadConfig()
     return;
 
   fileName=pathFromRoot(_project->configPath(L"Config." + _name + L".txt"));
+  minimumVisualStudioVersion=(int) _minimumVisualStudioVersion;
 
-  config.open(fileName);
-  if (!config)
-    return;
-
-  while (!config.eof())
+  // The sections are collected first and merged afterwards so the same lists can be restored from the cache.
+  if (!_project->configCache().get(fileName,record))
   {
-    line=readLine(config);
-    if (line == L"[DEPENDENCIES]")
-      addLines(config,_dependencies);
-    else if (line == L"[INCLUDES]")
-      addLines(config,_includes);
-    else if (line == L"[CPP]")
-      addLines(config,_cppFiles);
-    else if (line == L"[VISUAL_STUDIO]")
-      _minimumVisualStudioVersion=parseVisualStudioVersion(readLine(config));
-    else if (line == L"[DEFINES_LIB]")
-      addLines(config,_definesLib);
+    TraceEvent
+      event(_project->trace(),L"config",L"Parse module config");
+
+    event.argument(L"file",fileName);
+    record.addFile(fileName);
+
+    config.open(nativePath(fileName));
+    if (config)
+    {
+      while (!config.eof())
+      {
+        line=readLine(config);
+        if (line == L"[DEPENDENCIES]")
+          addLines(config,dependencies);
+        else if (line == L"[INCLUDES]")
+          addLines(config,includes);
+        else if (line == L"[CPP]")
+          addLines(config,cppFiles);
+        else if (line == L"[VISUAL_STUDIO]")
+          minimumVisualStudioVersion=(int) parseVisualStudioVersion(readLine(config));
+        else if (line == L"[DEFINES_LIB]")
+          addLines(config,definesLib);
+      }
+
+      config.close();
+    }
   }
 
-  config.close();
+  record.value(dependencies);
+  record.value(includes);
+  record.value(cppFiles);
+  record.value(minimumVisualStudioVersion);
+  record.value(definesLib);
+
+  if (!record.isLoading())
+    _project->configCache().set(fileName,record);
+
+  merge(dependencies,_dependencies);
+  merge(includes,_includes);
+  merge(cppFiles,_cppFiles);
+  merge(definesLib,_definesLib);
+  _minimumVisualStudioVersion=(VisualStudioVersion) minimumVisualStudioVersion;
 }
 
 void ProjectFile::merge(ProjectFile *projectFile)
@@ -202,54 +324,173 @@ void ProjectFile::merge(ProjectFile *projectFile)
   merge(projectFile->_definesLib,_definesLib);
 }
 
-void ProjectFile::write(const vector<Project*> &allprojects)
+void ProjectFile::write(const DependencyGraph &graph,const OutputWriter &outputWriter)
 {
-  wofstream
-    file;
+  wstringstream
+    file,
+    filter;
 
   wstring
-    projectDir(pathFromRoot(_wizard->solutionName() + L".Projects\\" + name()));
+    projectDir(pathFromRoot(projectDirectory()));
 
-  filesystem::create_directories(projectDir.c_str());
+  TraceEvent
+    event(_project->trace(),L"project",_fileName);
 
-  file.open(projectDir + L"\\" + _fileName);
-  if (!file)
-    return;
+  filesystem::create_directories(nativePath(projectDir));
 
   loadSource();
+  _cppFilesMatcher=FileMatcher(_cppFiles);
+  writePrecompiledHeaderFile(projectDir,outputWriter);
+  writeUnityFiles(projectDir,outputWriter);
 
-  write(file,allprojects);
+  write(file,graph);
+  outputWriter.write(projectDir + L"\\" + _fileName,file.str());
 
-  file.close();
+  if (!_libraryCacheInputs.empty())
+    outputWriter.write(projectDir + L"\\" + libraryCacheInputsFileName,_libraryCacheInputs);
 
-  file.open(projectDir + L"\\" + _fileName + L".filters");
-  if (!file)
-    return;
+  writeFilter(filter);
+  outputWriter.write(projectDir + L"\\" + _fileName + L".filters",filter.str());
+
+  event.argument(L"sourceFiles",_srcFiles.size());
+  event.argument(L"includeFiles",_includeFiles.size());
+  event.argument(L"unityFiles",_unityFiles.size());
+}
 
-  writeFilter(file);
+size_t ProjectFile::sourceFileCount() const
+{
+  return(_srcFiles.size());
+}
 
-  file.close();
+const vector<wstring> &ProjectFile::sourceFiles() const
+{
+  return(_srcFiles);
 }
 
 bool ProjectFile::isLib() const
 {
-  return(_project->isLib() || (_wizard->solutionType() != SolutionType::DYNAMIC_MT && _project->isDll()));
+  return(_project->isLib() || (_options->solutionType() != SolutionType::DYNAMIC_MT && _project->isDll()));
 }
 
-const wstring ProjectFile::libDirectory() const
+const wstring ProjectFile::libDirectory(const wstring &configuration) const
 {
-    return(rootPath + L"Artifacts\\lib\\");
+  return(artifactsDirectory(configuration) + L"lib\\");
 }
 
-const wstring ProjectFile::outputDirectory() const
+const wstring ProjectFile::outputDirectory(const wstring &configuration) const
 {
   if (_project->isFuzz())
-    return(rootPath + L"Artifacts\\fuzz\\");
+    return(artifactsDirectory(configuration) + L"fuzz\\");
 
   if (isLib())
-    return(libDirectory());
+    return(libDirectory(configuration));
 
-  return(binDirectory());
+  return(binDirectory(configuration));
+}
+
+void ProjectFile::addCompileCommands(const DependencyGraph &graph,const wstring &compiler,const wstring &directory,vector<string> &commands) const
+{
+  vector<wstring>
+    collections[3];
+
+  wstring
+    flags,
+    intermediateDirectory,
+    precompiledHeader,
+    projectDir;
+
+  // The commands use the same files and object names as the Release configuration of the project file.
+  projectDir=projectDirectory() + L"\\";
+  intermediateDirectory=projectDir + getIntermediateDirectoryName(L"Release");
+  flags=compileFlags(graph) + pathMapFlags(compiler,directory);
+  collections[0]=_srcFiles;
+  collections[1]=_unityFiles;
+  if (!_precompiledHeaderFile.empty())
+  {
+    collections[2].push_back(_precompiledHeaderFile);
+    precompiledHeader=intermediateDirectory + (_project->isExe() ? _name : getTargetName(false)) + L".pch";
+  }
+
+  for (auto& collection : collections)
+  {
+    map<wstring,int>
+      fileCount;
+
+    for (auto& f : collection)
+    {
+      wstring
+        object,
+        source;
+
+      wstringstream
+        command;
+
+      if (endsWith(f,L".asm") || endsWith(f,L".h") || endsWith(f,L".rc") || (_unitySrcFiles.find(f) != _unitySrcFiles.end()))
+        continue;
+
+      object=getObjectFileName(f,fileCount);
+      if (object.empty())
+      {
+        object=f.substr(f.find_last_of(L"\\") + 1);
+        object=object.substr(0,object.find_last_of(L".")) + L".obj";
+      }
+      object=intermediateDirectory + object;
+      source=f.find(L'\\') == wstring::npos ? projectDir + f : fromRoot(f);
+
+      command << compiler << " /nologo " << flags << " " << languageFlags(f);
+      if (f == _precompiledHeaderFile)
+        command << " /Yc\"" << _project->precompiledHeader() << "\" /Fp" << quoteArgument(precompiledHeader);
+      else if (usesPrecompiledHeader(f))
+        command << " /Yu\"" << _project->precompiledHeader() << "\" /Fp" << quoteArgument(precompiledHeader);
+      command << " /c " << quoteArgument(source) << " /Fo" << quoteArgument(object);
+
+      commands.push_back("{\"directory\":" + jsonString(directory) + ",\"command\":" + jsonString(command.str()) +
+        ",\"file\":" + jsonString(source) + ",\"output\":" + jsonString(object) + "}");
+    }
+  }
+}
+
+void ProjectFile::addFingerprint(const DependencyGraph &graph,vector<wstring> &settings,vector<wstring> &files) const
+{
+  vector<wstring>
+    folders;
+
+  // The flags of the Release configuration also contain the defines, include directories and runtime library.
+  settings.push_back(L"toolset " + _options->platformToolset());
+  settings.push_back(L"platform " + _options->platformName());
+  settings.push_back(L"flags " + compileFlags(graph));
+  for (auto& library : _project->libraries())
+    settings.push_back(L"library " + library);
+
+  for (auto& f : _srcFiles)
+  {
+    files.push_back(fromRoot(f));
+    if ((f.find(L'\\') != wstring::npos) && !contains(folders,fromRoot(f.substr(0,f.find_last_of(L"\\")))))
+      folders.push_back(fromRoot(f.substr(0,f.find_last_of(L"\\"))));
+  }
+  for (auto& f : _includeFiles)
+    files.push_back(fromRoot(f));
+  for (auto& f : _resourceFiles)
+    files.push_back(fromRoot(f));
+  // The other headers next to a source file can be included without an include directory.
+  for (auto& folder : folders)
+    addFingerprintFiles(folder,false,files);
+  for (auto& directory : graph.includeDirectories(this))
+    addFingerprintFiles(directory,true,files);
+  sort(files.begin(),files.end());
+  files.erase(unique(files.begin(),files.end()),files.end());
+}
+
+void ProjectFile::addFingerprintFiles(const wstring &directory,const bool recursive,vector<wstring> &files) const
+{
+  // The headers that are copied into the include directories, like zconf.h, are found here as well.
+  for (auto& entry : _project->directoryIndex().entries(pathFromRoot(directory)))
+  {
+    if (entry.isRegularFile())
+      files.push_back(directory + L"\\" + entry.name());
+    else if (recursive && entry.isDirectory() && (entry.name()[0] != L'.'))
+      addFingerprintFiles(directory + L"\\" + entry.name(),true,files);
+  }
 }
 
 void ProjectFile::addFile(const wstring &name)
@@ -262,12 +503,12 @@ void ProjectFile::addFile(const wstring &name)
   {
     src_file=_project->filePath(name + ext);
 
-    if (filesystem::exists(pathFromRoot(src_file)))
+    if (_project->directoryIndex().fileExists(pathFromRoot(src_file)))
     {
       _srcFiles.push_back(rootPath + src_file);
 
       header_file=_project->filePath(name + L".h");
-      if (filesystem::exists(pathFromRoot(header_file)))
+      if (_project->directoryIndex().fileExists(pathFromRoot(header_file)))
         _includeFiles.push_back(rootPath + header_file);
 
       break;
@@ -281,12 +522,12 @@ void ProjectFile::addFile(const wstring &name)
   {
     src_file=_project->filePath(L"main" + ext);
 
-    if (filesystem::exists(pathFromRoot(src_file)))
+    if (_project->directoryIndex().fileExists(pathFromRoot(src_file)))
     {
       _srcFiles.push_back(rootPath + src_file);
 
       header_file=_project->filePath(name + L".h");
-      if (filesystem::exists(pathFromRoot(header_file)))
+      if (_project->directoryIndex().fileExists(pathFromRoot(header_file)))
         _includeFiles.push_back(rootPath + header_file);
 
       break;
@@ -310,9 +551,41 @@ void ProjectFile::addLines(wifstream &config,vector<wstring> &container)
   }
 }
 
+void ProjectFile::addNinjaLibraries(const DependencyGraph &graph,vector<wstring> &libraries) const
+{
+  // Static libraries do not contain the libraries they use, these are passed on to the linker.
+  for (auto& reference : graph.references(this))
+  {
+    if (reference->isLib())
+    {
+      if (contains(libraries,reference->ninjaTarget()))
+        continue;
+
+      libraries.push_back(reference->ninjaTarget());
+      reference->addNinjaLibraries(graph,libraries);
+    }
+    else if (reference->_project->isDll() && !contains(libraries,reference->ninjaImportLibrary()))
+      libraries.push_back(reference->ninjaImportLibrary());
+  }
+}
+
+void ProjectFile::addSharedLibraries(const DependencyGraph &graph,vector<const ProjectFile*> &libraries) const
+{
+  // The libraries that are shared by the variants can also use other shared libraries.
+  for (auto& reference : graph.references(this))
+  {
+    if ((reference->_project->isVariantSensitive()) || (find(libraries.begin(),libraries.end(),reference) != libraries.end()))
+      continue;
+
+    if (!reference->isLib() && reference->_project->isDll())
+      libraries.push_back(reference);
+    reference->addSharedLibraries(graph,libraries);
+  }
+}
+
 const wstring ProjectFile::asmOptions() const
 {
-  switch (_wizard->platform())
+  switch (_options->platform())
   {
     case Platform::X86: return(L"ml /nologo /c /Cx /safeseh /coff /Fo\"$(IntDir)%(Filename).obj\" \"%(FullPath)\"");
     case Platform::X64: return(L"ml64 /nologo /c /Cx /Fo\"$(IntDir)%(Filename).obj\" \"%(FullPath)\"");
@@ -321,6 +594,100 @@ const wstring ProjectFile::asmOptions() const
   }
 }
 
+bool ProjectFile::compilesAsCpp(const wstring &fileName) const
+{
+  if (_project->compiler() == Compiler::CPP)
+    return(true);
+
+  if (endsWith(fileName,L".cpp") || endsWith(fileName,L".cc"))
+    return(true);
+
+  return(_cppFilesMatcher.matches(replace(fileName,L"..\\",L"")));
+}
+
+const wstring ProjectFile::compileFlags(const DependencyGraph &graph) const
+{
+  const OptimizationProfile
+    &profile(_project->optimizationProfile());
+
+  wstring
+    definition,
+    floatingPointModel;
+
+  wstringstream
+    definitions,
+    flags;
+
+  flags << (_options->solutionType() == SolutionType::STATIC_MT ? "/MT" : "/MD");
+  flags << " /GF /Gy /GS /EHsc /Zc:inline /Z7";
+  if (_project->warningLevel() == 0)
+    flags << " /w";
+  else
+    flags << " /W" << _project->warningLevel();
+  if (_project->treatWarningAsError())
+    flags << " /WX";
+  if (_options->useOpenMP())
+    flags << " /openmp";
+  if (_project->isOptimizationDisable())
+    flags << " /Od";
+  else if (profile.optimization() == L"MinSpace")
+    flags << " /O1 /Oy";
+  else
+    flags << " /O2 /Oy";
+  if (profile.inlineFunctionExpansion() == L"Disabled")
+    flags << " /Ob0";
+  else if (profile.inlineFunctionExpansion() == L"OnlyExplicitInline")
+    flags << " /Ob1";
+  else if (profile.inlineFunctionExpansion() == L"AnySuitable")
+    flags << " /Ob2";
+  if (!_project->isOptimizationDisable() && !profile.favorSizeOrSpeed().empty())
+    flags << (profile.favorSizeOrSpeed() == L"Size" ? " /Os" : " /Ot");
+  if (profile.intrinsicFunctions())
+    flags << " /Oi";
+  floatingPointModel=profile.floatingPointModel();
+  transform(floatingPointModel.begin(),floatingPointModel.end(),floatingPointModel.begin(),::towlower);
+  if (!floatingPointModel.empty())
+    flags << " /fp:" << floatingPointModel;
+  if (useLinkTimeCodeGeneration(L"Release"))
+    flags << " /GL";
+  // The root folder is trimmed by pathMapFlags, it should not be part of the fingerprint of the library cache.
+  if (_options->reproducible())
+    flags << " /Brepro";
+  flags << " /source-charset:utf-8";
+  if (useInstructionSet())
+    flags << " /arch:" << _options->instructionSetName();
+  if (!profile.additionalOptions().empty())
+    flags << " " << trim(profile.additionalOptions());
+
+  if (!generatedIncludeDirectory().empty())
+    flags << " /I" << quoteArgument(generatedIncludeDirectory());
+  for (auto& directory : graph.includeDirectories(this))
+    flags << " /I" << quoteArgument(directory);
+  if (_options->useOpenCL() && _project->useOpenCL())
+    flags << " /IBuild\\OpenCL";
+
+  writePreprocessorDefinitions(definitions,false);
+  while (getline(definitions,definition,L';'))
+    flags << " /D" << quoteArgument(definition);
+  if (_project->useUnicode())
+    flags << " /DUNICODE /D_UNICODE";
+  else
+    flags << " /D_MBCS";
+
+  return(flags.str());
+}
+
+const wstring ProjectFile::configurationType() const
+{
+  if (isLib())
+    return(L"StaticLibrary");
+
+  if (_project->isDll())
+    return(L"DynamicLibrary");
+
+  return(L"Application");
+}
+
 const wstring ProjectFile::getFilter(const wstring &fileName,vector<wstring> &filters) const
 {
   wstring
@@ -346,9 +713,42 @@ const wstring ProjectFile::getFilter(const wstring &fileName,vector<wstring> &fi
   return filter;
 }
 
-const wstring ProjectFile::getIntermediateDirectoryName(const bool debug) const
+const wstring ProjectFile::getIntermediateDirectoryName(const wstring &configuration) const
 {
-  return((debug ? L"Debug\\" : L"Release\\") + _wizard->platformName() + L"\\");
+  // The profile guided configurations compile the same objects and only link them differently.
+  if (startsWith(configuration,L"PG"))
+    return(L"PGO\\" + _options->platformName() + L"\\");
+
+  return(configuration + L"\\" + _options->platformName() + L"\\");
+}
+
+const wstring ProjectFile::getObjectFileName(const wstring &fileName,map<wstring,int> &fileCount) const
+{
+  int
+    count;
+
+  wstring
+    name;
+
+  count=++fileCount[fileName.substr(fileName.find_last_of(L"\\") + 1)];
+  if ((count == 1) || (_cppFilesMatcher.matches(replace(fileName,L"..\\",L""))))
+    return(L"");
+
+  name=fileName.substr(0,fileName.find_last_of(L"."));
+  name=name.substr(name.find_last_of(L"\\") + 1);
+  return(name + L"_" + to_wstring(count) + L".obj");
+}
+
+const wstring ProjectFile::generatedIncludeDirectory() const
+{
+  // The headers in this folder are found before the ones that are shared by all solutions in the source tree.
+  if (!_project->isVariantSensitive())
+    return(L"");
+
+  if (_options->shareDependencies() || (!_options->formats().empty() && _project->name() == _options->magickCoreProjectName()))
+    return(_options->solutionName() + L".Projects\\Include");
+
+  return(L"");
 }
 
 const wstring ProjectFile::getTargetName(const bool debug) const
@@ -363,6 +763,17 @@ const wstring ProjectFile::getTargetName(const bool debug) const
   return(targetName);
 }
 
+const wstring ProjectFile::languageFlags(const wstring &fileName) const
+{
+  if (!compilesAsCpp(fileName))
+    return(L"/std:c17");
+
+  if (endsWith(fileName,L".cpp") || endsWith(fileName,L".cc"))
+    return(L"/std:c++17");
+
+  return(L"/TP /std:c++17");
+}
+
 void ProjectFile::loadModule()
 {
   if (!_reference.empty())
@@ -376,16 +787,21 @@ void ProjectFile::loadSource()
   wstring
     resourceFile;
 
+  // The library cache needs the files before the project is written, so this can be called twice.
+  _includeFiles.clear();
+  _resourceFiles.clear();
+  _srcFiles.clear();
+
   for (auto& dir : _project->directories())
   {
-    if ((_project->isModule()) && (_project->isExe() || (_project->isDll() && _wizard->solutionType() == SolutionType::DYNAMIC_MT)))
+    if ((_project->isModule()) && (_project->isExe() || (_project->isDll() && _options->solutionType() == SolutionType::DYNAMIC_MT)))
       loadModule();
     else
       loadSource(dir);
   }
 
   resourceFile=_project->configPath(L"ImageMagick.rc");
-  if (filesystem::exists(pathFromRoot(resourceFile)))
+  if (_project->directoryIndex().fileExists(pathFromRoot(resourceFile)))
     _resourceFiles.push_back(rootPath + resourceFile);
 }
 
@@ -394,21 +810,21 @@ void ProjectFile::loadSource(const wstring &directory)
   wstring
     path=_project->filePath(directory);
 
-  if (contains(_project->platformExcludes(_wizard->platform()),directory))
+  if (_project->platformExcludes(_options->platform()).matches(directory))
     return;
 
-  if (!directoryExists(pathFromRoot(path)))
+  if (!_project->directoryIndex().directoryExists(pathFromRoot(path)))
     throwException(L"Invalid folder specified: " + path);
 
-  for (const auto& entry : filesystem::directory_iterator(pathFromRoot(path)))
+  for (const auto& entry : _project->directoryIndex().entries(pathFromRoot(path)))
   {
     wstring
       fileName;
 
-    if (!entry.is_regular_file())
+    if (!entry.isRegularFile())
       continue;
 
-    fileName=entry.path().filename();
+    fileName=entry.name();
     if (isExcluded(fileName))
       continue;
 
@@ -426,12 +842,12 @@ const wstring ProjectFile::nasmOptions(const wstring &folder) const
   wstring
     result=L"";
 
-  if (_wizard->platform() == Platform::ARM64)
+  if (_options->platform() == Platform::ARM64)
     return(result);
 
   result += rootPath + L"Build\\nasm -i\"" + folder +L"\"";
 
-  if (_wizard->platform() == Platform::X86)
+  if (_options->platform() == Platform::X86)
     result += L" -fwin32 -DWIN32";
   else
     result += L" -fwin64 -DWIN64 -D__x86_64__";
@@ -443,6 +859,47 @@ const wstring ProjectFile::nasmOptions(const wstring &folder) const
   return(result);
 }
 
+const wstring ProjectFile::ninjaImportLibrary() const
+{
+  return(fromRoot(libDirectory(L"Release")) + getTargetName(false) + L".lib");
+}
+
+const wstring ProjectFile::ninjaLinkFlags() const
+{
+  wstring
+    libraryDirectory;
+
+  wstringstream
+    flags;
+
+  // A trailing backslash would escape the closing quote of the argument.
+  libraryDirectory=fromRoot(libDirectory(L"Release"));
+  libraryDirectory.pop_back();
+  flags << "/MACHINE:" << _options->machineName() << " /INCREMENTAL:NO /LIBPATH:" << quoteArgument(libraryDirectory);
+  if (_options->linkTimeCodeGeneration() == LinkTimeCodeGeneration::FULL)
+    flags << " /LTCG";
+  else if (_options->linkTimeCodeGeneration() == LinkTimeCodeGeneration::INCREMENTAL)
+    flags << " /LTCG:INCREMENTAL";
+  if (_options->reproducible())
+    flags << " /Brepro";
+  if (_project->isConsole())
+    flags << " /SUBSYSTEM:CONSOLE";
+  else
+  {
+    flags << " /SUBSYSTEM:WINDOWS";
+    if (_project->isDll())
+    {
+      flags << " /DLL /IMPLIB:" << quoteArgument(ninjaImportLibrary());
+      if (!_project->moduleDefinitionFile().empty())
+        flags << " /DEF:" << quoteArgument(_project->filePath(_project->moduleDefinitionFile()));
+    }
+    else if (_project->useUnicode())
+      flags << " /ENTRY:wWinMainCRTStartup";
+  }
+
+  return(flags.str());
+}
+
 void ProjectFile::merge(vector<wstring> &input, vector<wstring> &output)
 {
   for (auto& value : input)
@@ -452,45 +909,122 @@ void ProjectFile::merge(vector<wstring> &input, vector<wstring> &output)
   }
 }
 
+const wstring ProjectFile::pathMapFlags(const wstring &compiler,const wstring &root) const
+{
+  // The debug information of /Z7 contains the absolute paths of the sources and the working folder,
+  // the root folder is removed from them like the property sheet does for MSBuild.
+  if (!_options->reproducible())
+    return(L"");
+
+  if (compiler.find(L"clang") != wstring::npos)
+    return(L" " + quoteArgument(L"/clang:-ffile-prefix-map=" + root + L"\\="));
+
+  // The backslash is doubled before a closing quote, otherwise it would escape the quote.
+  if (root.find(L' ') != wstring::npos)
+    return(L" \"/d1trimfile:" + root + L"\\\\\"");
+
+  return(L" /d1trimfile:" + root + L"\\");
+}
+
+const vector<wstring> ProjectFile::preprocessorDefinitions() const
+{
+  vector<wstring>
+    definitions;
+
+  definitions=_project->defines();
+  if (isLib() || (_options->solutionType() != SolutionType::DYNAMIC_MT && (_project->isExe())))
+  {
+    definitions.insert(definitions.end(),_definesLib.begin(),_definesLib.end());
+    definitions.push_back(L"_LIB");
+  }
+  else if (_project->isDll())
+  {
+    definitions.insert(definitions.end(),_project->definesDll().begin(),_project->definesDll().end());
+    definitions.push_back(L"_DLL");
+    definitions.push_back(L"_MAGICKMOD_");
+  }
+  if (_project->isExe() && _options->solutionType() != SolutionType::STATIC_MT)
+    definitions.push_back(L"_AFXDLL");
+
+  return(definitions);
+}
+
 void ProjectFile::setFileName()
 {
   _fileName=_prefix+L"_"+_name+L".vcxproj";
 }
 
-void ProjectFile::write(wofstream &file,const vector<Project*> &allProjects) const
+bool ProjectFile::usesLibraryCache() const
+{
+  // The fingerprint does not cover magick-baseconfig.h, so only the libraries of the dependencies are cached.
+  return(!_options->libraryCacheDirectory().empty() && !_project->isVariantSensitive() && isLib());
+}
+
+bool ProjectFile::useInstructionSet() const
+{
+  if (_options->instructionSetName().empty() || _project->isInstructionSetDisabled())
+    return(false);
+
+  // Projects that use NASM already select their SIMD code at runtime.
+  return(!_project->useNasm());
+}
+
+bool ProjectFile::useLinkTimeCodeGeneration(const wstring &configuration) const
+{
+  if (configuration == L"Debug")
+    return(false);
+
+  if ((configuration == L"Release") && (_options->linkTimeCodeGeneration() == LinkTimeCodeGeneration::DISABLED))
+    return(false);
+
+  if (_project->isLinkTimeCodeGenerationDisabled() || _project->isOptimizationDisable() || _project->useNasm())
+    return(false);
+
+  // Objects created by the assembler cannot take part in link time code generation.
+  for (auto& f : _srcFiles)
+  {
+    if (endsWith(f,L".asm"))
+      return(false);
+  }
+
+  return(true);
+}
+
+bool ProjectFile::usesPrecompiledHeader(const wstring &fileName) const
+{
+  if (_precompiledHeaderFile.empty() || endsWith(fileName,L".asm"))
+    return(false);
+
+  if (_project->precompiledHeaderExcludes().matches(fileName.substr(fileName.find_last_of(L"\\") + 1)))
+    return(false);
+
+  // A precompiled header can only be used by files of the same language.
+  return(compilesAsCpp(fileName) == compilesAsCpp(_precompiledHeaderFile));
+}
+
+void ProjectFile::write(wostream &file,const DependencyGraph &graph) const
 {
   file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << endl;
   file << "<Project DefaultTargets=\"Build\" ToolsVersion=\"4.0\" xmlns=\"http://schemas.microsoft.com/developer/msbuild/2003\">" << endl;
   file << "  <ItemGroup Label=\"ProjectConfigurations\">" << endl;
-  file << "    <ProjectConfiguration Include=\"Debug|" << _wizard->platformName() << "\">" << endl;
-  file << "      <Configuration>Debug</Configuration>" << endl;
-  file << "      <Platform>" << _wizard->platformName() << "</Platform>" << endl;
-  file << "    </ProjectConfiguration>" << endl;
-  file << "    <ProjectConfiguration Include=\"Release|" << _wizard->platformName() << "\">" << endl;
-  file << "      <Configuration>Release</Configuration>" << endl;
-  file << "      <Platform>" << _wizard->platformName() << "</Platform>" << endl;
-  file << "    </ProjectConfiguration>" << endl;
+  for (auto& configuration : _options->configurations())
+  {
+    file << "    <ProjectConfiguration Include=\"" << configuration << "|" << _options->platformName() << "\">" << endl;
+    file << "      <Configuration>" << configuration << "</Configuration>" << endl;
+    file << "      <Platform>" << _options->platformName() << "</Platform>" << endl;
+    file << "    </ProjectConfiguration>" << endl;
+  }
   file << "  </ItemGroup>" << endl;
   file << "  <PropertyGroup Label=\"Globals\">" << endl;
   file << "    <ProjectName>" << _prefix << "_" << _name << "</ProjectName>" << endl;
   file << "    <ProjectGuid>{" << _guid << "}</ProjectGuid>" << endl;
-  file << "    <Keyword>" << _wizard->platformName() << "Proj</Keyword>" << endl;
+  file << "    <Keyword>" << _options->platformName() << "Proj</Keyword>" << endl;
   file << "  </PropertyGroup>" << endl;
   file << "  <Import Project=\"$(VCTargetsPath)\\Microsoft.Cpp.Default.props\" />" << endl;
 
   file << "  <PropertyGroup Label=\"Configuration\">" << endl;
-  if (isLib())
-    file << "    <ConfigurationType>StaticLibrary</ConfigurationType>" << endl;
-  else if (_project->isDll())
-    file << "    <ConfigurationType>DynamicLibrary</ConfigurationType>" << endl;
-  else if (_project->isExe())
-    file << "    <ConfigurationType>Application</ConfigurationType>" << endl;
-  if (_wizard->visualStudioVersion() == VisualStudioVersion::VS2017)
-    file << "    <PlatformToolset>v141</PlatformToolset>" << endl;
-  else if (_wizard->visualStudioVersion() == VisualStudioVersion::VS2019)
-    file << "    <PlatformToolset>v142</PlatformToolset>" << endl;
-  else if (_wizard->visualStudioVersion() == VisualStudioVersion::VS2022)
-    file << "    <PlatformToolset>v143</PlatformToolset>" << endl;
+  file << "    <ConfigurationType>" << configurationType() << "</ConfigurationType>" << endl;
+  file << "    <PlatformToolset>" << _options->platformToolset() << "</PlatformToolset>" << endl;
   file << "    <UseOfMfc>false</UseOfMfc>" << endl;
   if (_project->useUnicode())
     file << "    <CharacterSet>Unicode</CharacterSet>" << endl;
@@ -499,100 +1033,79 @@ void ProjectFile::write(wofstream &file,const vector<Project*> &allProjects) con
   file << "  </PropertyGroup>" << endl;
 
   file << "  <Import Project=\"$(VCTargetsPath)\\Microsoft.Cpp.props\" />" << endl;
+  file << "  <ImportGroup Label=\"PropertySheets\">" << endl;
+  file << "    <Import Project=\"..\\Solution.props\" />" << endl;
+  file << "    <Import Project=\"..\\" << configurationType() << ".props\" />" << endl;
+  file << "  </ImportGroup>" << endl;
 
   file << "  <PropertyGroup>" << endl;
   file << "    <LinkIncremental>false</LinkIncremental>" << endl;
-  file << "    <OutDir>" << outputDirectory() << "</OutDir>" << endl;
+  file << "    <OutDir>" << outputDirectory(L"Release") << "</OutDir>" << endl;
+  for (auto& configuration : _options->configurations())
+  {
+    if (outputDirectory(configuration) != outputDirectory(L"Release"))
+      file << "    <OutDir Condition=\"'$(Configuration)|$(Platform)'=='" << configuration << "|" << _options->platformName() << "'\">" << outputDirectory(configuration) << "</OutDir>" << endl;
+  }
   if (_project->isExe())
   {
     file << "    <TargetName>" << _name << "</TargetName>" << endl;
   }
   else
   {
-    file << "    <TargetName Condition=\"'$(Configuration)|$(Platform)'=='Debug|" << _wizard->platformName() << "'\">" << getTargetName(true) << "</TargetName>" << endl;
-    file << "    <TargetName Condition=\"'$(Configuration)|$(Platform)'=='Release|" << _wizard->platformName() << "'\">" << getTargetName(false) << "</TargetName>" << endl;
+    for (auto& configuration : _options->configurations())
+      file << "    <TargetName Condition=\"'$(Configuration)|$(Platform)'=='" << configuration << "|" << _options->platformName() << "'\">" << getTargetName(configuration == L"Debug") << "</TargetName>" << endl;
   }
-  file << "    <IntDir Condition=\"'$(Configuration)|$(Platform)'=='Debug|" << _wizard->platformName() << "'\">" << getIntermediateDirectoryName(true) << "</IntDir>" << endl;
-  file << "    <IntDir Condition=\"'$(Configuration)|$(Platform)'=='Release|" << _wizard->platformName() << "'\">" << getIntermediateDirectoryName(false) << "</IntDir>" << endl;
-  if (_wizard->visualStudioVersion() >= VisualStudioVersion::VS2019)
-    file << "    <UseDebugLibraries Condition=\"'$(Configuration)|$(Platform)'=='Debug|" << _wizard->platformName() << "'\">true</UseDebugLibraries>" << endl;
+  for (auto& configuration : _options->configurations())
+    file << "    <IntDir Condition=\"'$(Configuration)|$(Platform)'=='" << configuration << "|" << _options->platformName() << "'\">" << getIntermediateDirectoryName(configuration) << "</IntDir>" << endl;
+  if (_options->visualStudioVersion() >= VisualStudioVersion::VS2019)
+    file << "    <UseDebugLibraries Condition=\"'$(Configuration)|$(Platform)'=='Debug|" << _options->platformName() << "'\">true</UseDebugLibraries>" << endl;
   file << "  </PropertyGroup>" << endl;
 
-  writeItemDefinitionGroup(file,true,allProjects);
-  writeItemDefinitionGroup(file,false,allProjects);
+  for (auto& configuration : _options->configurations())
+    writeItemDefinitionGroup(file,configuration,graph);
+
+  if (!_libraryCacheDirectory.empty())
+    writeLibraryCache(file);
 
   writeFiles(file,_srcFiles);
+  writeFiles(file,_unityFiles);
+  if (!_precompiledHeaderFile.empty())
+    writeFiles(file,vector<wstring>(1,_precompiledHeaderFile));
   writeFiles(file,_includeFiles);
   writeFiles(file,_resourceFiles);
 
-  writeProjectReferences(file,allProjects);
+  writeProjectReferences(file,graph);
 
   file << "  <Import Project=\"$(VCTargetsPath)\\Microsoft.Cpp.targets\" />" << endl;
   file << "</Project>" << endl;
 }
 
-void ProjectFile::writeAdditionalDependencies(wofstream &file,const wstring &separator) const
+void ProjectFile::writeAdditionalDependencies(wostream &file,const wstring &separator) const
 {
   for (auto& lib : _project->libraries())
-    file << separator << lib;
+    file << lib << separator;
 }
 
-void ProjectFile::writeAdditionalIncludeDirectories(wofstream &file,const wstring &separator,const vector<Project*> &allProjects) const
+void ProjectFile::writeAdditionalIncludeDirectories(wostream &file,const wstring &separator,const DependencyGraph &graph) const
 {
-  size_t
-    index;
+  if (!generatedIncludeDirectory().empty())
+    file << separator << rootPath << generatedIncludeDirectory();
 
-  for (auto& includeDir :_includes)
-  {
-    const Project
-      *project;
-
-    wstring
-      directory;
-
-    project=_project;
-    directory=includeDir;
-    index=includeDir.find(L"->");
-    if (index != -1)
-    {
-      wstring
-        projectName;
-
-      project=(const Project *) NULL;
-      projectName=directory.substr(0,index);
-      for (const auto& depp : allProjects)
-      {
-        if (depp->name() != projectName)
-          continue;
-
-        directory=directory.substr(index+2);
-        project=depp;
-        break;
-      }
-
-      if (project == (const Project *) NULL)
-        throwException(L"Invalid dependency specified: " + projectName);
-    }
-    
-    file << separator << rootPath << project->filePath(directory);
-  }
+  for (auto& directory : graph.includeDirectories(this))
+    file << separator << rootPath << directory;
 
-  if (_wizard->useOpenCL() && _project->useOpenCL())
+  if (_options->useOpenCL() && _project->useOpenCL())
     file << separator << rootPath << L"Build\\OpenCL";
 }
 
-void ProjectFile::writeFiles(wofstream &file,const vector<wstring> &collection) const
+void ProjectFile::writeFiles(wostream &file,const vector<wstring> &collection) const
 {
-  int
-    count;
-
-  map<wstring, int>
+  map<wstring,int>
     fileCount;
 
   wstring
-    fileName,
     folder,
-    name;
+    objectFileName;
 
   if (collection.size() == 0)
     return;
@@ -622,26 +1135,25 @@ void ProjectFile::writeFiles(wofstream &file,const vector<wstring> &collection)
         file << "    </CustomBuild>" << endl;
       }
     }
+    else if (_unitySrcFiles.find(f) != _unitySrcFiles.end())
+    {
+      file << "    <ClCompile Include=\"" << f << "\">" << endl;
+      file << "      <ExcludedFromBuild>true</ExcludedFromBuild>" << endl;
+      file << "    </ClCompile>" << endl;
+    }
     else
     {
-      fileName=f.substr(f.find_last_of(L"\\") + 1);
-
-      count=1;
-      if (fileCount.find(fileName) == fileCount.end())
-        fileCount.insert(make_pair(fileName,count));
-      else
-        count=++fileCount[fileName];
+      objectFileName=getObjectFileName(f,fileCount);
 
       file << "    <ClCompile Include=\"" << f << "\">" << endl;
-      name=replace(f,L"..\\",L"");
-      if (contains(_cppFiles,name))
+      if (_cppFilesMatcher.matches(replace(f,L"..\\",L"")))
         file << "      <CompileAs>CompileAsCpp</CompileAs>" << endl;
-      else if (count > 1)
-      {
-        name=f.substr(0,f.find_last_of(L"."));
-        name=name.substr(name.find_last_of(L"\\") + 1);
-        file << "      <ObjectFileName>$(IntDir)" << name << "_" << count << ".obj</ObjectFileName>" << endl;
-      }
+      else if (!objectFileName.empty())
+        file << "      <ObjectFileName>$(IntDir)" << objectFileName << "</ObjectFileName>" << endl;
+      if (f == _precompiledHeaderFile)
+        file << "      <PrecompiledHeader>Create</PrecompiledHeader>" << endl;
+      else if (!_precompiledHeaderFile.empty() && !usesPrecompiledHeader(f))
+        file << "      <PrecompiledHeader>NotUsing</PrecompiledHeader>" << endl;
       file << "      <MultiProcessorCompilation>true</MultiProcessorCompilation>" << endl;
       file << "    </ClCompile>" << endl;
     }
@@ -649,7 +1161,7 @@ void ProjectFile::writeFiles(wofstream &file,const vector<wstring> &collection)
   file << "  </ItemGroup>" << endl;
 }
 
-void ProjectFile::writeFilter(wofstream &file) const
+void ProjectFile::writeFilter(wostream &file) const
 {
   wstring
     filter;
@@ -678,6 +1190,10 @@ void ProjectFile::writeFilter(wofstream &file) const
     else
       file << "    <" << tagName << L" Include=\"" << f << "\" />" << endl;
   }
+  for (auto& f : _unityFiles)
+    file << "    <ClCompile Include=\"" << f << "\" />" << endl;
+  if (!_precompiledHeaderFile.empty())
+    file << "    <ClCompile Include=\"" << _precompiledHeaderFile << "\" />" << endl;
   file << "  </ItemGroup>" << endl;
   file << "  <ItemGroup>" << endl;
   for (auto& f : _includeFiles)
@@ -704,157 +1220,466 @@ void ProjectFile::writeFilter(wofstream &file) const
   file << "</Project>" << endl;
 }
 
-void ProjectFile::writeItemDefinitionGroup(wofstream &file,const bool debug,const vector<Project*> &allProjects) const
+void ProjectFile::writeItemDefinitionGroup(wostream &file,const wstring &configuration,const DependencyGraph &graph) const
 {
+  bool
+    debug;
+
+  const OptimizationProfile
+    &profile(_project->optimizationProfile());
+
   wstring
+    additionalOptions,
     name;
 
+  debug=configuration == L"Debug";
   name=getTargetName(debug);
 
-  file << "  <ItemDefinitionGroup Condition=\"'$(Configuration)|$(Platform)'=='" << (debug ? "Debug" : "Release") << "|" << _wizard->platformName() << "'\">" << endl;
+  // The settings that are the same for every project of the solution are in the imported property sheets.
+  file << "  <ItemDefinitionGroup Condition=\"'$(Configuration)|$(Platform)'=='" << configuration << "|" << _options->platformName() << "'\">" << endl;
   file << "    <ClCompile>" << endl;
-  file << "      <RuntimeLibrary>MultiThreaded" << (debug ? "Debug" : "") << (_wizard->solutionType() == SolutionType::STATIC_MT ? "" : "DLL") << "</RuntimeLibrary>" << endl;
-  file << "      <StringPooling>true</StringPooling>" << endl;
-  file << "      <FunctionLevelLinking>true</FunctionLevelLinking>" << endl;
   if (_project->warningLevel() == 0)
     file << "      <WarningLevel>TurnOffAllWarnings</WarningLevel>" << endl;
   else
     file << "      <WarningLevel>Level" << _project->warningLevel() << "</WarningLevel>" << endl;
   if (_project->treatWarningAsError())
     file << "      <TreatWarningAsError>true</TreatWarningAsError>" << endl;
-  file << "      <SuppressStartupBanner>true</SuppressStartupBanner>" << endl;
   if (_project->compiler() == Compiler::CPP)
     file << "      <CompileAs>CompileAsCpp</CompileAs>" << endl;
-  file << "      <InlineFunctionExpansion>" << (debug ? "Disabled" : "AnySuitable") << "</InlineFunctionExpansion>" << endl;
-  file << "      <OpenMPSupport>" << (_wizard->useOpenMP() ? "true" : "false") << "</OpenMPSupport>" << endl;
-  file << "      <DebugInformationFormat>ProgramDatabase</DebugInformationFormat>" << endl;
-  file << "      <ProgramDatabaseFileName>" << binDirectory() << (_project->isExe() ? _name : name) << ".pdb</ProgramDatabaseFileName>" << endl;
-  file << "      <BasicRuntimeChecks>" << (debug ? "EnableFastChecks" : "Default") << "</BasicRuntimeChecks>" << endl;
-  file << "      <OmitFramePointers>" << (debug ? "false" : "true") << "</OmitFramePointers>" << endl;
-  file << "      <Optimization>" << (debug || _project->isOptimizationDisable() ? "Disabled" : "MaxSpeed") << "</Optimization>" << endl;
+  if (!_precompiledHeaderFile.empty())
+  {
+    file << "      <PrecompiledHeader>Use</PrecompiledHeader>" << endl;
+    file << "      <PrecompiledHeaderFile>" << _project->precompiledHeader() << "</PrecompiledHeaderFile>" << endl;
+  }
+  if (debug || !profile.inlineFunctionExpansion().empty())
+    file << "      <InlineFunctionExpansion>" << (debug ? L"Disabled" : profile.inlineFunctionExpansion()) << "</InlineFunctionExpansion>" << endl;
+  if (!debug && profile.intrinsicFunctions())
+    file << "      <IntrinsicFunctions>true</IntrinsicFunctions>" << endl;
+  if (!debug && !profile.floatingPointModel().empty())
+    file << "      <FloatingPointModel>" << profile.floatingPointModel() << "</FloatingPointModel>" << endl;
+  if (!_options->reproducible() || !isLib())
+    file << "      <ProgramDatabaseFileName>" << binDirectory(configuration) << (_project->isExe() ? _name : name) << ".pdb</ProgramDatabaseFileName>" << endl;
+  file << "      <Optimization>" << (debug || _project->isOptimizationDisable() ? L"Disabled" : profile.optimization()) << "</Optimization>" << endl;
+  if (!debug && !_project->isOptimizationDisable() && !profile.favorSizeOrSpeed().empty())
+    file << "      <FavorSizeOrSpeed>" << profile.favorSizeOrSpeed() << "</FavorSizeOrSpeed>" << endl;
+  if (useLinkTimeCodeGeneration(configuration))
+    file << "      <WholeProgramOptimization>true</WholeProgramOptimization>" << endl;
   file << "      <AdditionalIncludeDirectories>";
-  writeAdditionalIncludeDirectories(file,L";",allProjects);
+  writeAdditionalIncludeDirectories(file,L";",graph);
   file << ";%(AdditionalIncludeDirectories)</AdditionalIncludeDirectories>" << endl;
   file << "      <PreprocessorDefinitions>";
-  writePreprocessorDefinitions(file,debug);
-  file << ";%(PreprocessorDefinitions)</PreprocessorDefinitions>" << endl;
-  file << "      <AdditionalOptions>/source-charset:utf-8 %(AdditionalOptions)</AdditionalOptions>" << endl;
-  file << "      <MultiProcessorCompilation>true</MultiProcessorCompilation>" << endl;
-  file << "      <LanguageStandard>stdcpp17</LanguageStandard>" << endl;
-  file << "      <LanguageStandard_C>stdc17</LanguageStandard_C>" << endl;
+  for (auto& definition : preprocessorDefinitions())
+    file << definition << ";";
+  file << "%(PreprocessorDefinitions)</PreprocessorDefinitions>" << endl;
+  if (useInstructionSet())
+    additionalOptions+=L"/arch:" + _options->instructionSetName() + L" ";
+  if (!debug)
+    additionalOptions+=profile.additionalOptions();
+  if (!additionalOptions.empty())
+    file << "      <AdditionalOptions>" << additionalOptions << "%(AdditionalOptions)</AdditionalOptions>" << endl;
   file << "    </ClCompile>" << endl;
-  file << "    <ResourceCompile>" << endl;
-  file << "      <PreprocessorDefinitions>" << (debug ? "_DEBUG" : "NDEBUG") <<";%(PreprocessorDefinitions)</PreprocessorDefinitions>" << endl;
-  file << "      <Culture>0x0409</Culture>" << endl;
-  file << "    </ResourceCompile>" << endl;
 
   if (isLib())
   {
     file << "    <Lib>" << endl;
-    file << "      <AdditionalLibraryDirectories>" << libDirectory() << ";%(AdditionalLibraryDirectories)</AdditionalLibraryDirectories>" << endl;
-    file << "      <AdditionalDependencies>/MACHINE:" << (_wizard->machineName());
-    writeAdditionalDependencies(file,L";");
-    file << ";%(AdditionalDependencies)</AdditionalDependencies>" << endl;
-    file << "      <SuppressStartupBanner>true</SuppressStartupBanner>" << endl;
+    if (!_project->libraries().empty())
+    {
+      file << "      <AdditionalDependencies>";
+      writeAdditionalDependencies(file,L";");
+      file << "%(AdditionalDependencies)</AdditionalDependencies>" << endl;
+    }
+    if (useLinkTimeCodeGeneration(configuration))
+      file << "      <LinkTimeCodeGeneration>true</LinkTimeCodeGeneration>" << endl;
     file << "    </Lib>" << endl;
   }
   else
   {
     file << "    <Link>" << endl;
-    file << "      <AdditionalLibraryDirectories>" << libDirectory() << ";%(AdditionalLibraryDirectories)</AdditionalLibraryDirectories>" << endl;
-    file << "      <AdditionalDependencies>/MACHINE:" << _wizard->machineName();
-    writeAdditionalDependencies(file,L";");
-    file << ";%(AdditionalDependencies)</AdditionalDependencies>" << endl;
-    file << "      <SuppressStartupBanner>true</SuppressStartupBanner>" << endl;
-    file << "      <TargetMachine>Machine" << _wizard->machineName() << "</TargetMachine>" << endl;
-    file << "      <GenerateDebugInformation>" << (debug ? "true" : "false") << "</GenerateDebugInformation>" << endl;
-    file << "      <ProgramDatabaseFile>" << binDirectory() << (_project->isExe() ? _name : name) << ".pdb</ProgramDatabaseFile>" << endl;
-    file << "      <ImportLibrary>" << libDirectory() << name << ".lib</ImportLibrary>" << endl;
-    if (!_project->isConsole())
+    if (!_project->libraries().empty())
     {
-      if (_project->isDll())
-        file << "      <LinkDLL>true</LinkDLL>" << endl;
-      else if (_project->useUnicode())
-        file << "    <EntryPointSymbol>wWinMainCRTStartup</EntryPointSymbol>" << endl;
-      file << "      <SubSystem>Windows</SubSystem>" << endl;
-      if ((_project->isDll()) && (!_project->moduleDefinitionFile().empty()))
-        file << "      <ModuleDefinitionFile>" << rootPath <<  _project->filePath(_project->moduleDefinitionFile()) << "</ModuleDefinitionFile>" << endl;
+      file << "      <AdditionalDependencies>";
+      writeAdditionalDependencies(file,L";");
+      file << "%(AdditionalDependencies)</AdditionalDependencies>" << endl;
     }
-    else
+    file << "      <ProgramDatabaseFile>" << binDirectory(configuration) << (_project->isExe() ? _name : name) << ".pdb</ProgramDatabaseFile>" << endl;
+    file << "      <ImportLibrary>" << libDirectory(configuration) << name << ".lib</ImportLibrary>" << endl;
+    // The optimized image is linked in its own folder with the profile that was trained with the instrumented one.
+    if (configuration == L"PGOptimize")
+      file << "      <ProfileGuidedDatabase>" << outputDirectory(L"PGInstrument") << (_project->isExe() ? _name : name) << ".pgd</ProfileGuidedDatabase>" << endl;
+    if ((_project->isDll()) && (!_project->moduleDefinitionFile().empty()))
+      file << "      <ModuleDefinitionFile>" << rootPath <<  _project->filePath(_project->moduleDefinitionFile()) << "</ModuleDefinitionFile>" << endl;
+    else if (_project->isConsole())
       file << "      <SubSystem>Console</SubSystem>" << endl;
+    else if (_project->isExe())
+    {
+      if (_project->useUnicode())
+        file << "      <EntryPointSymbol>wWinMainCRTStartup</EntryPointSymbol>" << endl;
+      file << "      <SubSystem>Windows</SubSystem>" << endl;
+    }
     file << "    </Link>" << endl;
+    writeSharedLibraries(file,configuration,graph);
   }
   file << "  </ItemDefinitionGroup>" << endl;
 }
 
-void ProjectFile::writePreprocessorDefinitions(wofstream &file,const bool debug) const
+void ProjectFile::writeLibraryCache(wostream &file) const
 {
-  file << (debug ? "_DEBUG" : "NDEBUG") << ";_WINDOWS;WIN32;_VISUALC_;NeedFunctionPrototypes;_WIN32_WINNT=0x0601";
-  for (auto& def : _project->defines())
+  wstring
+    condition,
+    pdbFileName;
+
+  // Only the Release configuration is cached, the other configurations are still compiled.
+  condition=L"'$(Configuration)|$(Platform)'=='Release|" + _options->platformName() + L"'";
+  if (!_options->reproducible())
+    pdbFileName=binDirectory(L"Release") + getTargetName(false) + L".pdb";
+
+  file << "  <ItemDefinitionGroup Condition=\"" << condition << "\">" << endl;
+  if (_libraryCached)
   {
-    file << ";" << def;
+    file << "    <ClCompile>" << endl;
+    file << "      <ExcludedFromBuild>true</ExcludedFromBuild>" << endl;
+    file << "    </ClCompile>" << endl;
+    file << "    <CustomBuild>" << endl;
+    file << "      <ExcludedFromBuild>true</ExcludedFromBuild>" << endl;
+    file << "    </CustomBuild>" << endl;
   }
-  if (isLib() || (_wizard->solutionType() != SolutionType::DYNAMIC_MT && (_project->isExe())))
+  file << "    <PostBuildEvent>" << endl;
+  file << "      <Command>";
+  if (_libraryCached)
   {
-    for (auto& def : _definesLib)
-    {
-      file << ";" << def;
-    }
-    file << ";_LIB";
+    if (!pdbFileName.empty())
+      file << "if exist \"" << _libraryCacheDirectory << "\\" << getTargetName(false) << ".pdb\" copy /y \"" << _libraryCacheDirectory << "\\" << getTargetName(false) << ".pdb\" \"" << pdbFileName << "\" &gt; nul";
   }
-  else if (_project->isDll())
+  else
+  {
+    // The fingerprint was computed when Configure was run, an input that changed since then is not in the library that is stored.
+    file << "powershell -NoProfile -ExecutionPolicy Bypass -Command \"$ErrorActionPreference='Stop'; foreach ($line in Get-Content '" << libraryCacheInputsFileName << "') { ";
+    file << "$values=$line.Split(' ',2); if ((Get-Item -LiteralPath $values[1]).LastWriteTimeUtc.ToFileTimeUtc() -ne [long]$values[0]) { ";
+    file << "Write-Output ('warning: ' + $values[1] + ' changed after Configure was run, the library is not stored in the cache.'); exit 1 } }\" || exit /b 0" << endl;
+    // The library is copied last and renamed, other builds only use an entry when the library exists.
+    file << "if not exist \"" << _libraryCacheDirectory << "\" mkdir \"" << _libraryCacheDirectory << "\"" << endl;
+    if (!pdbFileName.empty())
+      file << "if exist \"" << pdbFileName << "\" copy /y \"" << pdbFileName << "\" \"" << _libraryCacheDirectory << "\\" << getTargetName(false) << ".pdb\" &gt; nul" << endl;
+    file << "copy /y \"$(TargetPath)\" \"" << _libraryCacheDirectory << "\\" << libraryName() << ".tmp\" &gt; nul" << endl;
+    file << "move /y \"" << _libraryCacheDirectory << "\\" << libraryName() << ".tmp\" \"" << _libraryCacheDirectory << "\\" << libraryName() << "\" &gt; nul";
+  }
+  file << "</Command>" << endl;
+  file << "    </PostBuildEvent>" << endl;
+  file << "  </ItemDefinitionGroup>" << endl;
+
+  if (!_libraryCached)
+    return;
+
+  // The librarian copies the objects of the cached library into the output of the project.
+  file << "  <ItemGroup Condition=\"" << condition << "\">" << endl;
+  file << "    <Library Include=\"" << _libraryCacheDirectory << "\\" << libraryName() << "\" />" << endl;
+  file << "  </ItemGroup>" << endl;
+}
+
+void ProjectFile::writeNinja(wostream &file,const DependencyGraph &graph) const
+{
+  int
+    count;
+
+  map<wstring,int>
+    fileCount;
+
+  vector<wstring>
+    libraries,
+    objects,
+    sources;
+
+  wstring
+    flagsVariable,
+    header,
+    object,
+    objectDir,
+    precompiledHeader,
+    projectDir,
+    stem;
+
+  // The objects are kept apart from the ones that MSBuild creates for the same project.
+  projectDir=projectDirectory() + L"\\";
+  objectDir=projectDir + getIntermediateDirectoryName(L"Ninja");
+  flagsVariable=L"cflags_" + replace(name(),L".",L"_");
+  file << "# " << name() << endl;
+  file << flagsVariable << " = " << NinjaFile::escape(compileFlags(graph) + pathMapFlags(_options->ninjaCompiler(),rootDirectory())) << endl;
+
+  for (auto& f : _srcFiles)
   {
-    for (auto& def : _project->definesDll())
+    if (_unitySrcFiles.find(f) == _unitySrcFiles.end())
+      sources.push_back(f);
+  }
+  for (auto& f : _unityFiles)
+    sources.push_back(f);
+  if (!_precompiledHeaderFile.empty())
+  {
+    precompiledHeader=objectDir + L"precompiled.pch";
+    header=L"\"" + _project->precompiledHeader() + L"\"";
+    sources.insert(sources.begin(),_precompiledHeaderFile);
+  }
+
+  for (auto& f : sources)
+  {
+    wstring
+      source;
+
+    // The generated files are placed next to the project file.
+    source=f.find(L'\\') == wstring::npos ? projectDir + f : fromRoot(f);
+    stem=source.substr(source.find_last_of(L"\\") + 1);
+    stem=stem.substr(0,stem.find_last_of(L"."));
+    count=++fileCount[stem];
+    object=objectDir + stem + (count > 1 ? L"_" + to_wstring(count) : L"") + L".obj";
+    objects.push_back(object);
+
+    if (endsWith(f,L".asm"))
     {
-      file << ";" << def;
+      file << "build " << NinjaFile::escapePath(object) << ": " << (_project->useNasm() ? "nasm " : "asm ") << NinjaFile::escapePath(source) << endl;
+      if (_project->useNasm())
+      {
+        file << "  nasmflags = -i" << NinjaFile::escape(quoteArgument(source.substr(0,source.find_last_of(L"\\") + 1)));
+        file << (_options->platform() == Platform::X86 ? " -fwin32 -DWIN32" : " -fwin64 -DWIN64 -D__x86_64__");
+        for (auto& include : _project->includesNasm())
+          file << " -i" << NinjaFile::escape(quoteArgument(_project->filePath(include) + L"\\"));
+        file << endl;
+      }
+      continue;
     }
-    file << ";_DLL;_MAGICKMOD_";
+
+    if (f == _precompiledHeaderFile)
+      file << "build " << NinjaFile::escapePath(object) << " | " << NinjaFile::escapePath(precompiledHeader) << ": cc " << NinjaFile::escapePath(source) << endl;
+    else if (usesPrecompiledHeader(f))
+      file << "build " << NinjaFile::escapePath(object) << ": cc " << NinjaFile::escapePath(source) << " | " << NinjaFile::escapePath(precompiledHeader) << endl;
+    else
+      file << "build " << NinjaFile::escapePath(object) << ": cc " << NinjaFile::escapePath(source) << endl;
+    file << "  cflags = $" << flagsVariable << endl;
+    file << "  langflags = " << languageFlags(f) << endl;
+    if (f == _precompiledHeaderFile)
+      file << "  pchflags = /Yc" << NinjaFile::escape(header) << " /Fp" << NinjaFile::escape(quoteArgument(precompiledHeader)) << endl;
+    else if (usesPrecompiledHeader(f))
+      file << "  pchflags = /Yu" << NinjaFile::escape(header) << " /Fp" << NinjaFile::escape(quoteArgument(precompiledHeader)) << endl;
   }
-  if (_project->isExe() && _wizard->solutionType() != SolutionType::STATIC_MT)
-    file << ";_AFXDLL";
-  if (_wizard->includeIncompatibleLicense())
-    file << ";_MAGICK_INCOMPATIBLE_LICENSES_";
+
+  if (isLib())
+  {
+    file << "build " << NinjaFile::escapePath(ninjaTarget()) << ": lib";
+    for (auto& o : objects)
+      file << " " << NinjaFile::escapePath(o);
+    file << endl;
+    file << "  libflags = /MACHINE:" << _options->machineName();
+    if (useLinkTimeCodeGeneration(L"Release"))
+      file << " /LTCG";
+    if (_options->reproducible())
+      file << " /Brepro";
+    for (auto& lib : _project->libraries())
+      file << " " << NinjaFile::escape(quoteArgument(lib));
+    file << endl;
+    file << endl;
+    return;
+  }
+
+  for (auto& f : _resourceFiles)
+  {
+    stem=f.substr(f.find_last_of(L"\\") + 1);
+    object=objectDir + stem.substr(0,stem.find_last_of(L".")) + L".res";
+    file << "build " << NinjaFile::escapePath(object) << ": rc " << NinjaFile::escapePath(fromRoot(f)) << endl;
+    objects.push_back(object);
+  }
+
+  addNinjaLibraries(graph,libraries);
+  file << "build " << NinjaFile::escapePath(ninjaTarget());
+  if (_project->isDll())
+    file << " | " << NinjaFile::escapePath(ninjaImportLibrary());
+  file << ": link";
+  for (auto& o : objects)
+    file << " " << NinjaFile::escapePath(o);
+  if (!libraries.empty())
+  {
+    file << " |";
+    for (auto& lib : libraries)
+      file << " " << NinjaFile::escapePath(lib);
+  }
+  file << endl;
+  file << "  ldflags = " << NinjaFile::escape(ninjaLinkFlags()) << endl;
+  file << "  libs =";
+  for (auto& lib : libraries)
+    file << " " << NinjaFile::escape(quoteArgument(lib));
+  for (auto& lib : _project->libraries())
+    file << " " << NinjaFile::escape(quoteArgument(lib));
+  file << endl;
+  file << endl;
 }
 
-void ProjectFile::writeProjectReferences(wofstream &file,const vector<Project*> &allProjects) const
+void ProjectFile::writePrecompiledHeaderFile(const wstring &projectDir,const OutputWriter &outputWriter)
 {
   size_t
-    index;
+    cCount,
+    cppCount;
+
+  wstringstream
+    content;
 
   wstring
-    projectName,
-    projectFileName;
+    fileName;
 
-  file << "  <ItemGroup>" << endl;
+  // Not every file includes the header first with the same defines yet, this is only used when requested.
+  if ((_project->precompiledHeader().empty()) || (!_options->precompiledHeaders()))
+    return;
 
-  for (auto& dep : _dependencies)
+  cCount=0;
+  cppCount=0;
+  for (auto& f : _srcFiles)
   {
-    projectName=dep;
-    projectFileName=L"";
-    index=dep.find(L">");
-    if (index != -1)
-    {
-      projectName=dep.substr(0,index);
-      projectFileName=dep.substr(index+1);
-    }
+    fileName=f.substr(f.find_last_of(L"\\") + 1);
+    if (endsWith(f,L".asm") || _project->precompiledHeaderExcludes().matches(fileName))
+      continue;
 
-    for (auto& depp : allProjects)
-    {
-      if (depp->name() != projectName)
-        continue;
+    if (compilesAsCpp(f))
+      cppCount++;
+    else
+      cCount++;
+  }
 
-      for (auto& deppf : depp->files())
-      {
-        if (projectFileName != L"" && deppf->_name != projectFileName)
-          continue;
+  if (cCount+cppCount == 0)
+    return;
 
-        file << "    <ProjectReference Include=\"..\\" << deppf->name() << "\\" << deppf->_fileName << "\">" << endl;
-        file << "      <Project>{" << deppf->guid() << "}</Project>" << endl;
-        file << "      <ReferenceOutputAssembly>false</ReferenceOutputAssembly>" << endl;
-        file << "    </ProjectReference>" << endl;
-      }
-    }
+  // The header is created in the language that most of the files use.
+  _precompiledHeaderFile=cppCount > cCount ? L"precompiled.cpp" : L"precompiled.c";
+  content << "/* Generated by Configure, do not edit. */" << endl;
+  content << "#include \"" << _project->precompiledHeader() << "\"" << endl;
+  outputWriter.write(projectDir + L"\\" + _precompiledHeaderFile,content.str());
+}
+
+void ProjectFile::writePreprocessorDefinitions(wostream &file,const bool debug) const
+{
+  PropertySheet::writePreprocessorDefinitions(file,*_options,debug);
+  for (auto& definition : preprocessorDefinitions())
+    file << ";" << definition;
+}
+
+void ProjectFile::writeProjectReferences(wostream &file,const DependencyGraph &graph) const
+{
+  file << "  <ItemGroup>" << endl;
+
+  for (auto& reference : graph.references(this))
+  {
+    // The shared dependencies are in the projects folder of another solution when the variants share them.
+    if (!_options->shareDependencies() || (reference->_project->isVariantSensitive() == _project->isVariantSensitive()))
+      file << "    <ProjectReference Include=\"..\\" << reference->name() << "\\" << reference->_fileName << "\">" << endl;
+    else
+      file << "    <ProjectReference Include=\"" << rootPath << reference->projectDirectory() << "\\" << reference->_fileName << "\">" << endl;
+    file << "      <Project>{" << reference->guid() << "}</Project>" << endl;
+    file << "      <ReferenceOutputAssembly>false</ReferenceOutputAssembly>" << endl;
+    file << "    </ProjectReference>" << endl;
   }
 
   file << "  </ItemGroup>" << endl;
 }
+
+void ProjectFile::writeSharedLibraries(wostream &file,const wstring &configuration,const DependencyGraph &graph) const
+{
+  bool
+    debug;
+
+  vector<const ProjectFile*>
+    libraries;
+
+  wstring
+    name;
+
+  if (!_options->shareDependencies() || !_project->isVariantSensitive())
+    return;
+
+  addSharedLibraries(graph,libraries);
+  if (libraries.empty())
+    return;
+
+  // The shared libraries are built in the bin folder of the shared solution and the variant cannot start without them.
+  debug=configuration == L"Debug";
+  file << "    <PostBuildEvent>" << endl;
+  file << "      <Command>";
+  for (size_t i=0; i < libraries.size(); i++)
+  {
+    name=libraries[i]->getTargetName(debug);
+    if (i > 0)
+      file << endl;
+    file << "copy /y \"" << libraries[i]->binDirectory(configuration) << name << ".dll\" \"" << outputDirectory(configuration) << name << ".dll\" &gt; nul" << endl;
+    file << "if exist \"" << libraries[i]->binDirectory(configuration) << name << ".pdb\" copy /y \"" << libraries[i]->binDirectory(configuration) << name << ".pdb\" \"" << outputDirectory(configuration) << name << ".pdb\" &gt; nul";
+  }
+  file << "</Command>" << endl;
+  file << "    </PostBuildEvent>" << endl;
+}
+
+void ProjectFile::writeUnityFiles(const wstring &projectDir,const OutputWriter &outputWriter)
+{
+  size_t
+    batchSize;
+
+  vector<wstring>
+    cFiles,
+    cxxFiles;
+
+  wstring
+    fileName;
+
+  if (_project->unityBatchSize() < 2)
+    return;
+
+  batchSize=(size_t) _project->unityBatchSize();
+  for (auto& f : _srcFiles)
+  {
+    fileName=f.substr(f.find_last_of(L"\\") + 1);
+    if (endsWith(f,L".asm") || _project->unityExcludes().matches(fileName))
+      continue;
+
+    // Files that cannot use the precompiled header cannot be placed after it.
+    if (!_precompiledHeaderFile.empty() && _project->precompiledHeaderExcludes().matches(fileName))
+      continue;
+
+    if (compilesAsCpp(f))
+      cxxFiles.push_back(f);
+    else
+      cFiles.push_back(f);
+  }
+
+  writeUnityFiles(projectDir,outputWriter,cFiles,L".c",batchSize);
+  writeUnityFiles(projectDir,outputWriter,cxxFiles,L".cpp",batchSize);
+}
+
+void ProjectFile::writeUnityFiles(const wstring &projectDir,const OutputWriter &outputWriter,const vector<wstring> &files,const wstring &extension,const size_t batchSize)
+{
+  size_t
+    batchCount,
+    count,
+    index;
+
+  wstring
+    unityFile;
+
+  if (files.size() < 2)
+    return;
+
+  // Spread the files evenly so the last batch is not left with a single file.
+  batchCount=(files.size()+batchSize-1)/batchSize;
+  index=0;
+  for (size_t i=0; i < batchCount; i++)
+  {
+    wstringstream
+      content;
+
+    count=(files.size()-index)/(batchCount-i);
+    unityFile=L"unity_" + to_wstring(_unityFiles.size() + 1) + extension;
+    content << "/* Generated by Configure, do not edit. */" << endl;
+    if (usesPrecompiledHeader(unityFile))
+      content << "#include \"" << _project->precompiledHeader() << "\"" << endl;
+    for (size_t j=index; j < index+count; j++)
+    {
+      content << "#include \"" << files[j] << "\"" << endl;
+      _unitySrcFiles.insert(files[j]);
+    }
+    index+=count;
+
+    outputWriter.write(projectDir + L"\\" + unityFile,content.str());
+    _unityFiles.push_back(unityFile);
+  }
+}
@@ -20,17 +20,22 @@
 #ifndef __ProjectFile__
 #define __ProjectFile__
 
-#include "ConfigureWizard.h"
+#include "FileMatcher.h"
+#include "Options.h"
+#include "OutputWriter.h"
+#include <map>
+#include <unordered_set>
 
+class DependencyGraph;
 class Project;
 
 class ProjectFile
 {
 public:
-  ProjectFile(const ConfigureWizard *wizard,Project *project,
+  ProjectFile(const Options *options,Project *project,
     const wstring &prefix,const wstring &name);
 
-  ProjectFile(const ConfigureWizard *wizard,Project *project,
+  ProjectFile(const Options *options,Project *project,
     const wstring &prefix,const wstring &name,const wstring &reference);
 
   const vector<wstring> &dependencies() const;
@@ -39,37 +44,81 @@ public:
 
   const wstring guid() const;
 
+  const vector<wstring> &includes() const;
+
+  const wstring libraryName() const;
+
+  const wstring moduleName() const;
+
   const wstring name() const;
 
+  const wstring ninjaTarget() const;
+
+  const wstring projectDirectory() const;
+
   const vector<wstring> &aliases() const;
 
+  void addCompileCommands(const DependencyGraph &graph,const wstring &compiler,const wstring &directory,vector<string> &commands) const;
+
+  void addFingerprint(const DependencyGraph &graph,vector<wstring> &settings,vector<wstring> &files) const;
+
   bool isSupported(const VisualStudioVersion visualStudioVersion) const;
 
+  void libraryCache(const wstring &directory,const bool cached,const wstring &inputs);
+
   void loadConfig();
 
+  void loadSource();
+
   void merge(ProjectFile *projectFile);
 
-  void write(const vector<Project*> &allProjects);
+  size_t sourceFileCount() const;
+
+  const vector<wstring> &sourceFiles() const;
+
+  bool usesLibraryCache() const;
+
+  void write(const DependencyGraph &graph,const OutputWriter &outputWriter);
+
+  void writeNinja(wostream &file,const DependencyGraph &graph) const;
 
 private:
 
-  const wstring binDirectory() const;
+  const wstring artifactsDirectory(const wstring &configuration) const;
+
+  const wstring binDirectory(const wstring &configuration) const;
 
   bool isLib() const;
 
-  const wstring libDirectory() const;
+  const wstring libDirectory(const wstring &configuration) const;
 
-  const wstring outputDirectory() const;
+  const wstring outputDirectory(const wstring &configuration) const;
 
   void addFile(const wstring &name);
 
+  void addFingerprintFiles(const wstring &directory,const bool recursive,vector<wstring> &files) const;
+
   void addLines(wifstream &config,vector<wstring> &container);
 
+  void addNinjaLibraries(const DependencyGraph &graph,vector<wstring> &libraries) const;
+
+  void addSharedLibraries(const DependencyGraph &graph,vector<const ProjectFile*> &libraries) const;
+
   const wstring asmOptions() const;
 
+  bool compilesAsCpp(const wstring &fileName) const;
+
+  const wstring compileFlags(const DependencyGraph &graph) const;
+
+  const wstring configurationType() const;
+
   const wstring getFilter(const wstring &fileName,vector<wstring> &filters) const;
 
-  const wstring getIntermediateDirectoryName(const bool debug) const;
+  const wstring getIntermediateDirectoryName(const wstring &configuration) const;
+
+  const wstring getObjectFileName(const wstring &fileName,map<wstring,int> &fileCount) const;
+
+  const wstring generatedIncludeDirectory() const;
 
   const wstring getTargetName(const bool debug) const;
 
@@ -79,52 +128,83 @@ private:
 
   bool isExcluded(const wstring &fileName);
 
+  const wstring languageFlags(const wstring &fileName) const;
+
   void loadAliases();
 
   void loadModule();
 
-  void loadSource();
-
   void loadSource(const wstring &directory);
 
   const wstring nasmOptions(const wstring &folder) const;
 
+  const wstring ninjaImportLibrary() const;
+
+  const wstring ninjaLinkFlags() const;
+
+  const wstring pathMapFlags(const wstring &compiler,const wstring &root) const;
+
+  const vector<wstring> preprocessorDefinitions() const;
+
   void merge(vector<wstring> &input, vector<wstring> &output);
 
   void setFileName();
 
-  void write(wofstream &file,const vector<Project*> &allProjects) const;
+  bool useInstructionSet() const;
+
+  bool useLinkTimeCodeGeneration(const wstring &configuration) const;
+
+  bool usesPrecompiledHeader(const wstring &fileName) const;
+
+  void write(wostream &file,const DependencyGraph &graph) const;
+
+  void writeFiles(wostream &file,const vector<wstring> &collection) const;
+
+  void writeFilter(wostream &file) const;
+
+  void writeAdditionalDependencies(wostream &file,const wstring &separator) const;
+
+  void writeAdditionalIncludeDirectories(wostream &file,const wstring &separator,const DependencyGraph &graph) const;
+
+  void writeItemDefinitionGroup(wostream &file,const wstring &configuration,const DependencyGraph &graph) const;
 
-  void writeFiles(wofstream &file,const vector<wstring> &collection) const;
+  void writeLibraryCache(wostream &file) const;
 
-  void writeFilter(wofstream &file) const;
+  void writePrecompiledHeaderFile(const wstring &projectDir,const OutputWriter &outputWriter);
 
-  void writeAdditionalDependencies(wofstream &file,const wstring &separator) const;
+  void writePreprocessorDefinitions(wostream &file,const bool debug) const;
 
-  void writeAdditionalIncludeDirectories(wofstream &file,const wstring &separator,const vector<Project*> &allProjects) const;
+  void writeProjectReferences(wostream &file,const DependencyGraph &graph) const;
 
-  void writeItemDefinitionGroup(wofstream &file,const bool debug,const vector<Project*> &allProjects) const;
+  void writeSharedLibraries(wostream &file,const wstring &configuration,const DependencyGraph &graph) const;
 
-  void writePreprocessorDefinitions(wofstream &file,const bool debug) const;
+  void writeUnityFiles(const wstring &projectDir,const OutputWriter &outputWriter);
 
-  void writeProjectReferences(wofstream &file,const vector<Project*> &allProjects) const;
+  void writeUnityFiles(const wstring &projectDir,const OutputWriter &outputWriter,const vector<wstring> &files,const wstring &extension,const size_t batchSize);
 
   vector<wstring>        _aliases;
   vector<wstring>        _cppFiles;
+  FileMatcher            _cppFilesMatcher;
   vector<wstring>        _dependencies;
   wstring                _fileName;
   wstring                _guid;
+  bool                   _libraryCached;
+  wstring                _libraryCacheDirectory;
+  wstring                _libraryCacheInputs;
   vector<wstring>        _includeFiles;
   vector<wstring>        _includes;
   vector<wstring>        _definesLib;
   VisualStudioVersion    _minimumVisualStudioVersion;
   wstring                _name;
+  const Options         *_options;
+  wstring                _precompiledHeaderFile;
   wstring                _prefix;
   Project               *_project;
   wstring                _reference;
   vector<wstring>        _resourceFiles;
   vector<wstring>        _srcFiles;
-  const ConfigureWizard *_wizard;
+  vector<wstring>        _unityFiles;
+  unordered_set<wstring> _unitySrcFiles;
 };
 
 #endif // __ProjectFile__
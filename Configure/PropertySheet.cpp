@@ -0,0 +1,202 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "PropertySheet.h"
+#include "Shared.h"
+
+static const wstring
+  rootPath(L"..\\..\\");
+
+PropertySheet::PropertySheet(const Options &options,const bool variantSensitive)
+  : _options(options),
+    _variantSensitive(variantSensitive)
+{
+}
+
+void PropertySheet::write(const OutputWriter &outputWriter) const
+{
+  wstringstream
+    application,
+    dynamicLibrary,
+    solution,
+    staticLibrary;
+
+  // The projects import these files, so the settings that are the same for all of them are only evaluated from here.
+  filesystem::create_directories(nativePath(fileName(L"Solution")).parent_path());
+
+  writeSolution(solution);
+  outputWriter.write(fileName(L"Solution"),solution.str());
+
+  writeStaticLibrary(staticLibrary);
+  outputWriter.write(fileName(L"StaticLibrary"),staticLibrary.str());
+
+  writeDynamicLibrary(dynamicLibrary);
+  outputWriter.write(fileName(L"DynamicLibrary"),dynamicLibrary.str());
+
+  writeApplication(application);
+  outputWriter.write(fileName(L"Application"),application.str());
+}
+
+void PropertySheet::writePreprocessorDefinitions(wostream &file,const Options &options,const bool debug)
+{
+  file << (debug ? "_DEBUG" : "NDEBUG") << ";_WINDOWS;WIN32;_VISUALC_;NeedFunctionPrototypes;_WIN32_WINNT=0x0601";
+  if (options.includeIncompatibleLicense())
+    file << ";_MAGICK_INCOMPATIBLE_LICENSES_";
+}
+
+const wstring PropertySheet::condition(const wstring &configuration) const
+{
+  return(L"'$(Configuration)|$(Platform)'=='" + configuration + L"|" + _options.platformName() + L"'");
+}
+
+const wstring PropertySheet::fileName(const wstring &name) const
+{
+  return(pathFromRoot((_variantSensitive ? _options.solutionName() : _options.sharedSolutionName()) + L".Projects\\" + name + L".props"));
+}
+
+void PropertySheet::writeApplication(wostream &file) const
+{
+  file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << endl;
+  file << "<Project ToolsVersion=\"4.0\" xmlns=\"http://schemas.microsoft.com/developer/msbuild/2003\">" << endl;
+  for (auto& configuration : _options.configurations())
+  {
+    file << "  <ItemDefinitionGroup Condition=\"" << condition(configuration) << "\">" << endl;
+    file << "    <ClCompile>" << endl;
+    file << "      <DebugInformationFormat>ProgramDatabase</DebugInformationFormat>" << endl;
+    file << "    </ClCompile>" << endl;
+    file << "    <Link>" << endl;
+    writeLink(file,configuration);
+    file << "    </Link>" << endl;
+    file << "  </ItemDefinitionGroup>" << endl;
+  }
+  file << "</Project>" << endl;
+}
+
+void PropertySheet::writeDynamicLibrary(wostream &file) const
+{
+  file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << endl;
+  file << "<Project ToolsVersion=\"4.0\" xmlns=\"http://schemas.microsoft.com/developer/msbuild/2003\">" << endl;
+  for (auto& configuration : _options.configurations())
+  {
+    file << "  <ItemDefinitionGroup Condition=\"" << condition(configuration) << "\">" << endl;
+    file << "    <ClCompile>" << endl;
+    file << "      <DebugInformationFormat>ProgramDatabase</DebugInformationFormat>" << endl;
+    file << "    </ClCompile>" << endl;
+    file << "    <Link>" << endl;
+    writeLink(file,configuration);
+    file << "      <LinkDLL>true</LinkDLL>" << endl;
+    file << "      <SubSystem>Windows</SubSystem>" << endl;
+    file << "    </Link>" << endl;
+    file << "  </ItemDefinitionGroup>" << endl;
+  }
+  file << "</Project>" << endl;
+}
+
+void PropertySheet::writeLibraryDirectories(wostream &file,const wstring &configuration) const
+{
+  file << "      <AdditionalLibraryDirectories>" << rootPath << _options.artifactsDirectory(_variantSensitive,configuration) << "lib\\;";
+  if (_variantSensitive && _options.shareDependencies())
+    file << rootPath << _options.artifactsDirectory(false,configuration) << "lib\\;";
+  file << "%(AdditionalLibraryDirectories)</AdditionalLibraryDirectories>" << endl;
+}
+
+void PropertySheet::writeLink(wostream &file,const wstring &configuration) const
+{
+  writeLibraryDirectories(file,configuration);
+  file << "      <AdditionalDependencies>/MACHINE:" << _options.machineName() << ";%(AdditionalDependencies)</AdditionalDependencies>" << endl;
+  file << "      <SuppressStartupBanner>true</SuppressStartupBanner>" << endl;
+  file << "      <TargetMachine>Machine" << _options.machineName() << "</TargetMachine>" << endl;
+  file << "      <GenerateDebugInformation>" << (configuration == L"Debug" ? "true" : "false") << "</GenerateDebugInformation>" << endl;
+  // The linker also needs this when only the static libraries were compiled with /GL.
+  if (configuration == L"PGInstrument")
+    file << "      <LinkTimeCodeGeneration>PGInstrument</LinkTimeCodeGeneration>" << endl;
+  else if (configuration == L"PGOptimize")
+    file << "      <LinkTimeCodeGeneration>PGOptimization</LinkTimeCodeGeneration>" << endl;
+  else if (configuration != L"Debug" && _options.linkTimeCodeGeneration() == LinkTimeCodeGeneration::FULL)
+    file << "      <LinkTimeCodeGeneration>UseLinkTimeCodeGeneration</LinkTimeCodeGeneration>" << endl;
+  else if (configuration != L"Debug" && _options.linkTimeCodeGeneration() == LinkTimeCodeGeneration::INCREMENTAL)
+    file << "      <LinkTimeCodeGeneration>UseFastLinkTimeCodeGeneration</LinkTimeCodeGeneration>" << endl;
+  // Only the name of the PDB is stored in the binary instead of its full path.
+  if (_options.reproducible())
+    file << "      <AdditionalOptions>/Brepro /PDBALTPATH:%25_PDB%25 %(AdditionalOptions)</AdditionalOptions>" << endl;
+}
+
+void PropertySheet::writeSolution(wostream &file) const
+{
+  bool
+    debug;
+
+  file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << endl;
+  file << "<Project ToolsVersion=\"4.0\" xmlns=\"http://schemas.microsoft.com/developer/msbuild/2003\">" << endl;
+  for (auto& configuration : _options.configurations())
+  {
+    debug=configuration == L"Debug";
+    file << "  <ItemDefinitionGroup Condition=\"" << condition(configuration) << "\">" << endl;
+    file << "    <ClCompile>" << endl;
+    file << "      <RuntimeLibrary>MultiThreaded" << (debug ? "Debug" : "") << (_options.solutionType() == SolutionType::STATIC_MT ? "" : "DLL") << "</RuntimeLibrary>" << endl;
+    file << "      <StringPooling>true</StringPooling>" << endl;
+    file << "      <FunctionLevelLinking>true</FunctionLevelLinking>" << endl;
+    file << "      <SuppressStartupBanner>true</SuppressStartupBanner>" << endl;
+    file << "      <OpenMPSupport>" << (_options.useOpenMP() ? "true" : "false") << "</OpenMPSupport>" << endl;
+    file << "      <BasicRuntimeChecks>" << (debug ? "EnableFastChecks" : "Default") << "</BasicRuntimeChecks>" << endl;
+    file << "      <OmitFramePointers>" << (debug ? "false" : "true") << "</OmitFramePointers>" << endl;
+    file << "      <PreprocessorDefinitions>";
+    writePreprocessorDefinitions(file,_options,debug);
+    file << ";%(PreprocessorDefinitions)</PreprocessorDefinitions>" << endl;
+    file << "      <AdditionalOptions>/source-charset:utf-8 ";
+    // The root folder is removed from __FILE__ and the debug information, the doubled backslash keeps the quote.
+    if (_options.reproducible())
+      file << "/Brepro /d1trimfile:\"$([System.IO.Path]::GetFullPath('$(MSBuildProjectDirectory)\\" << rootPath << "'))\\\" ";
+    file << "%(AdditionalOptions)</AdditionalOptions>" << endl;
+    file << "      <MultiProcessorCompilation>true</MultiProcessorCompilation>" << endl;
+    file << "      <LanguageStandard>stdcpp17</LanguageStandard>" << endl;
+    file << "      <LanguageStandard_C>stdc17</LanguageStandard_C>" << endl;
+    file << "    </ClCompile>" << endl;
+    file << "    <ResourceCompile>" << endl;
+    file << "      <PreprocessorDefinitions>" << (debug ? "_DEBUG" : "NDEBUG") <<";%(PreprocessorDefinitions)</PreprocessorDefinitions>" << endl;
+    file << "      <Culture>0x0409</Culture>" << endl;
+    file << "    </ResourceCompile>" << endl;
+    file << "  </ItemDefinitionGroup>" << endl;
+  }
+  file << "</Project>" << endl;
+}
+
+void PropertySheet::writeStaticLibrary(wostream &file) const
+{
+  file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << endl;
+  file << "<Project ToolsVersion=\"4.0\" xmlns=\"http://schemas.microsoft.com/developer/msbuild/2003\">" << endl;
+  for (auto& configuration : _options.configurations())
+  {
+    file << "  <ItemDefinitionGroup Condition=\"" << condition(configuration) << "\">" << endl;
+    file << "    <ClCompile>" << endl;
+    // The debug information of a library is stored in its objects, a shared PDB would differ between builds.
+    file << "      <DebugInformationFormat>" << (_options.reproducible() ? "OldStyle" : "ProgramDatabase") << "</DebugInformationFormat>" << endl;
+    file << "    </ClCompile>" << endl;
+    file << "    <Lib>" << endl;
+    writeLibraryDirectories(file,configuration);
+    file << "      <AdditionalDependencies>/MACHINE:" << _options.machineName() << ";%(AdditionalDependencies)</AdditionalDependencies>" << endl;
+    file << "      <SuppressStartupBanner>true</SuppressStartupBanner>" << endl;
+    if (_options.reproducible())
+      file << "      <AdditionalOptions>/Brepro %(AdditionalOptions)</AdditionalOptions>" << endl;
+    file << "    </Lib>" << endl;
+    file << "  </ItemDefinitionGroup>" << endl;
+  }
+  file << "</Project>" << endl;
+}
@@ -0,0 +1,56 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __PropertySheet__
+#define __PropertySheet__
+
+#include "Options.h"
+#include "OutputWriter.h"
+
+class PropertySheet
+{
+public:
+  PropertySheet(const Options &options,const bool variantSensitive);
+
+  void write(const OutputWriter &outputWriter) const;
+
+  static void writePreprocessorDefinitions(wostream &file,const Options &options,const bool debug);
+
+private:
+  const wstring condition(const wstring &configuration) const;
+
+  const wstring fileName(const wstring &name) const;
+
+  void writeApplication(wostream &file) const;
+
+  void writeDynamicLibrary(wostream &file) const;
+
+  void writeLibraryDirectories(wostream &file,const wstring &configuration) const;
+
+  void writeLink(wostream &file,const wstring &configuration) const;
+
+  void writeSolution(wostream &file) const;
+
+  void writeStaticLibrary(wostream &file) const;
+
+  const Options &_options;
+  const bool    _variantSensitive;
+};
+
+#endif // __PropertySheet__
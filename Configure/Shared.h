@@ -28,6 +28,10 @@
 
 enum class Compiler {Default, CPP};
 
+enum class InstructionSet {DEFAULT, AVX2, AVX512, ARMV8_2};
+
+enum class LinkTimeCodeGeneration {DISABLED, FULL, INCREMENTAL};
+
 enum class Platform {X86, X64, ARM64};
 
 enum class PolicyConfig {LIMITED, OPEN, SECURE, WEBSAFE};
@@ -81,14 +85,37 @@ static inline bool contains(const vector<wstring> &container, const wstring s)
   return(false);
 }
 
-static bool directoryExists(const std::wstring& folderPath)
+static inline bool equalsIgnoreCase(const wstring &value,const wchar_t *other)
 {
-  DWORD
-    folderAttr = GetFileAttributesW(folderPath.c_str());
+  size_t
+    length;
 
-  if (folderAttr == INVALID_FILE_ATTRIBUTES)
-    return false;
-  return (folderAttr & FILE_ATTRIBUTE_DIRECTORY);
+  length=wcslen(other);
+  if (value.length() != length)
+    return(false);
+
+  for (size_t i=0; i < length; i++)
+  {
+    if (towlower(value[i]) != towlower(other[i]))
+      return(false);
+  }
+
+  return(true);
+}
+
+static inline bool startsWithIgnoreCase(const wstring &value,const wchar_t *start)
+{
+  return(equalsIgnoreCase(value.substr(0,wcslen(start)),start));
+}
+
+static inline wstring toLower(const wstring &s)
+{
+  wstring
+    result;
+
+  result=s;
+  transform(result.begin(),result.end(),result.begin(),::towlower);
+  return(result);
 }
 
 static inline wstring trim(const wstring &s)
@@ -111,11 +138,52 @@ static inline string wstringToString(const wstring &ws)
   return(result);
 }
 
+static inline string jsonString(const wstring &value)
+{
+  char
+    buffer[8];
+
+  string
+    result;
+
+  result="\"";
+  for (auto& c : wstringToString(value))
+  {
+    if ((c == '"') || (c == '\\'))
+      result+='\\';
+    if ((unsigned char) c < 0x20)
+    {
+      snprintf(buffer,sizeof(buffer),"\\u%04x",c);
+      result+=buffer;
+      continue;
+    }
+    result+=c;
+  }
+  result+="\"";
+
+  return(result);
+}
+
 static inline void throwException(const wstring& message)
 {
   throw runtime_error(wstringToString(message));
 }
 
+// The paths in the model always use a backslash, this converts them before the file system is accessed.
+static inline const filesystem::path nativePath(const wstring &path)
+{
+#ifdef _WIN32
+  return(filesystem::path(path));
+#else
+  wstring
+    result;
+
+  result=path;
+  std::replace(result.begin(),result.end(),L'\\',L'/');
+  return(filesystem::path(result));
+#endif
+}
+
 static inline wstring readLine(wifstream &stream)
 {
   wstring
@@ -133,7 +201,7 @@ static inline wstring readLicense(const wstring &fileName)
   wstring
     content;
 
-  file.open(fileName);
+  file.open(nativePath(fileName));
   if (!file)
     throwException(L"Unable to open license file: " + fileName);
 
@@ -190,6 +258,18 @@ static inline const wstring pathFromRoot(const wstring &path)
   return(L"..\\" + path);
 }
 
+static inline const wstring rootDirectory()
+{
+  wstring
+    directory;
+
+  directory=filesystem::absolute(nativePath(pathFromRoot(L""))).lexically_normal().wstring();
+  if ((!directory.empty()) && ((directory.back() == L'\\') || (directory.back() == L'/')))
+    directory.pop_back();
+
+  return(directory);
+}
+
 static const wstring createGuid(const wstring &name)
 {
   hash<string>
@@ -19,23 +19,60 @@
 */
 #include "stdafx.h"
 #include "Solution.h"
+#include "CompilationDatabase.h"
+#include "CriticalPath.h"
+#include "LibraryCache.h"
+#include "NinjaFile.h"
+#include "PropertySheet.h"
 #include "Shared.h"
+#include "TrainingProject.h"
 #include "VersionInfo.h"
 
-Solution::Solution(const ConfigureWizard &wizard)
-  : _wizard(wizard)
+Solution::Solution(const Options &options)
+  : _configCache(pathFromRoot(L"Configure\\Configure.cache")),
+    _directoryIndex(_trace),
+    _options(options),
+    _outputWriter(_trace)
 {
+  _loadTime=0;
+}
+
+const ConfigCache &Solution::configCache() const
+{
+  return(_configCache);
+}
+
+const DependencyGraph &Solution::dependencyGraph() const
+{
+  return(_dependencyGraph);
+}
+
+const DirectoryIndex &Solution::directoryIndex() const
+{
+  return(_directoryIndex);
+}
+
+const OutputWriter &Solution::outputWriter() const
+{
+  return(_outputWriter);
 }
 
 int Solution::loadProjectFiles() const
 {
+  chrono::steady_clock::time_point
+    start;
+
   int
     count;
 
+  TraceEvent
+    event(_trace,L"phase",L"Load project files");
+
+  start=chrono::steady_clock::now();
   count=0;
   for (auto& project : _projects)
   {
-    if (!project->isSupported(_wizard.visualStudioVersion()))
+    if (!project->isSupported(_options.visualStudioVersion()))
       continue;
 
     if (!project->loadFiles())
@@ -47,82 +84,181 @@ int Solution::loadProjectFiles() const
       count++;
     }
 
-    project->checkFiles(_wizard.visualStudioVersion());
+    project->checkFiles(_options.visualStudioVersion());
 
     project->mergeProjectFiles();
   }
 
+  _dependencyGraph.build(_projects);
+
+  if (!_options.formats().empty())
+    count-=removeUnusedDependencies();
+
+  _configCache.save();
+  _loadTime+=chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now()-start).count();
+
+  event.argument(L"projectFiles",(size_t) count);
   return(count);
 }
 
+long long Solution::loadTime() const
+{
+  return(_loadTime);
+}
+
 void Solution::loadProjects()
 {
+  chrono::steady_clock::time_point
+    start;
+
+  _trace.enabled(!_options.traceFile().empty());
+
+  TraceEvent
+    event(_trace,L"phase",L"Load projects");
+
+  start=chrono::steady_clock::now();
+  _configCache.load();
+
   loadProjectsFromFolder(L"Dependencies", L"Dependencies");
   loadProjectsFromFolder(L"OptionalDependencies", L"OptionalDependencies");
   loadProjectsFromFolder(L"Projects", L"ImageMagick");
+
+  event.argument(L"projects",_projects.size());
+
+  _loadTime+=chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now()-start).count();
 }
 
-void Solution::write(WaitDialog &waitDialog) const
+void Solution::printStatistics(ostream &stream) const
+{
+  stream << "Configuration: loaded in " << _loadTime << " ms, " << _configCache.hitCount() << " cached, ";
+  stream << _configCache.missCount() << " parsed." << endl;
+  stream << "Directory index: " << _directoryIndex.directoryCount() << " folders listed, ";
+  stream << _directoryIndex.queryCount() << " file system queries answered from the index." << endl;
+  stream << "Output: " << _outputWriter.changedCount() << " files written, ";
+  stream << _outputWriter.unchangedCount() << " files unchanged." << endl;
+}
+
+const Trace &Solution::trace() const
+{
+  return(_trace);
+}
+
+void Solution::write(Progress &progress) const
 {
   int
     steps;
 
   VersionInfo
-    versionInfo;
+    versionInfo(_trace);
 
-  wofstream
+  wstringstream
     file;
 
-  steps=loadProjectFiles();
-  waitDialog.setSteps(steps+7);
-
-  waitDialog.nextStep(L"Writing configuration");
+  steps=loadProjectFiles()+8;
+  if (!_options.formats().empty())
+    steps++;
+  if (!_options.compileCommandsCompiler().empty())
+    steps++;
+  if (!_options.ninjaCompiler().empty())
+    steps++;
+  if (_options.solutionFilters())
+    steps++;
+  if (_options.profileGuidedOptimization())
+    steps++;
+  progress.setSteps(steps);
+
+  progress.nextStep(L"Writing configuration");
   writeMagickBaseConfig();
 
-  waitDialog.nextStep(L"Writing Makefile.PL");
+  progress.nextStep(L"Writing Makefile.PL");
   writeMakeFile();
 
-  waitDialog.nextStep(L"Writing config files");
+  progress.nextStep(L"Writing config files");
   createConfigFiles();
 
-  waitDialog.nextStep(L"Writing threshold-map.h");
+  progress.nextStep(L"Writing threshold-map.h");
   writeThresholdMap();
 
-  file.open(getFileName());
-  if (!file)
-    return;
+  if (!_options.formats().empty())
+  {
+    progress.nextStep(L"Writing coders-list.h");
+    writeCodersList();
+  }
 
-  waitDialog.nextStep(L"Writing solution");
+  progress.nextStep(L"Writing solution");
 
   write(file);
 
-  file.close();
+  _outputWriter.write(getFileName(),file.str());
 
-  for (auto& project : _projects)
+  PropertySheet(_options,true).write(_outputWriter);
+  if (_options.shareDependencies())
+    PropertySheet(_options,false).write(_outputWriter);
+
+  writeProjectFiles(progress);
+
+  if (!_options.criticalPathFile().empty())
+    writeCriticalPath();
+
+  if (!_options.compileCommandsCompiler().empty())
   {
-    for (auto& projectFile : project->files())
-    {
-      waitDialog.nextStep(L"Writing: " + projectFile->fileName());
-      projectFile->write(_projects);
-    }
+    progress.nextStep(L"Writing compile_commands.json");
+    writeCompilationDatabase();
   }
 
-  if (!versionInfo.load())
-    return;
+  if (!_options.ninjaCompiler().empty())
+  {
+    progress.nextStep(L"Writing ninja file");
+    writeNinjaFile();
+  }
+
+  if (_options.solutionFilters())
+  {
+    progress.nextStep(L"Writing solution filters");
+    writeSolutionFilters();
+  }
+
+  if (_options.profileGuidedOptimization())
+  {
+    progress.nextStep(L"Writing training project");
+    writeTrainingProject();
+  }
 
-  waitDialog.nextStep(L"Writing version");
-  writeVersion(versionInfo);
+  progress.nextStep(L"Loading version information");
+  if (versionInfo.load())
+  {
+    progress.nextStep(L"Writing version");
+    writeVersion(versionInfo);
 
-  waitDialog.nextStep(L"Writing installer config");
-  writeInstallerConfig(versionInfo);
+    progress.nextStep(L"Writing installer config");
+    writeInstallerConfig(versionInfo);
 
-  waitDialog.nextStep(L"Writing NOTICE.txt");
-  writeNotice(versionInfo);
+    progress.nextStep(L"Writing NOTICE.txt");
+    writeNotice(versionInfo);
+  }
+
+  if (_trace.enabled())
+    _trace.write(_options.traceFile());
 }
 
 const wstring Solution::getFileName() const
 {
-  return(pathFromRoot(_wizard.solutionName() + L"." + _wizard.platformAlias() + L".sln"));
+  return(pathFromRoot(_options.solutionName() + L"." + _options.platformAlias() + L".sln"));
+}
+
+void Solution::loadLibraryCache() const
+{
+  LibraryCache
+    libraryCache(_options,_dependencyGraph);
+
+  TraceEvent
+    event(_trace,L"phase",L"Fingerprint libraries");
+
+  for (auto& projectFile : _dependencyGraph.order())
+    libraryCache.add(projectFile);
+
+  event.argument(L"hits",libraryCache.hitCount());
+  event.argument(L"misses",libraryCache.missCount());
 }
 
 void Solution::loadProjectsFromFolder(const wstring &configFolder, const wstring &filesFolder)
@@ -130,12 +266,12 @@ void Solution::loadProjectsFromFolder(const wstring &configFolder, const wstring
   Project
     *project;
 
-  for (const auto& entry : filesystem::directory_iterator(pathFromRoot(configFolder)))
+  for (const auto& entry : _directoryIndex.entries(pathFromRoot(configFolder)))
   {
-    if (!entry.is_directory())
+    if (!entry.isDirectory())
       continue;
 
-    project=Project::create(_wizard,configFolder,filesFolder,entry.path().filename());
+    project=Project::create(_options,_directoryIndex,_configCache,_trace,configFolder,filesFolder,entry.name());
     if (project != (Project *) NULL)
     {
       project->updateProjectNames();
@@ -144,7 +280,62 @@ void Solution::loadProjectsFromFolder(const wstring &configFolder, const wstring
   }
 }
 
-void Solution::replaceVersionVariables(const VersionInfo &versionInfo,wifstream &input,wofstream &output) const
+int Solution::removeUnusedDependencies() const
+{
+  int
+    count;
+
+  ProjectFile
+    *projectFile;
+
+  unordered_set<const ProjectFile*>
+    used;
+
+  vector<ProjectFile*>
+    pending;
+
+  TraceEvent
+    event(_trace,L"phase",L"Remove unused dependencies");
+
+  // Everything that is not reachable from the ImageMagick projects is only needed by the coders that were left out.
+  for (auto& project : _projects)
+  {
+    if (project->isDependency())
+      continue;
+
+    for (auto& file : project->files())
+      pending.push_back(file);
+  }
+
+  while (!pending.empty())
+  {
+    projectFile=pending.back();
+    pending.pop_back();
+    if (!used.insert(projectFile).second)
+      continue;
+
+    for (auto& reference : _dependencyGraph.references(projectFile))
+      pending.push_back(reference);
+  }
+
+  count=0;
+  for (auto& project : _projects)
+  {
+    if (!project->isDependency())
+      continue;
+
+    count+=(int) project->files().size();
+    project->removeFiles(used);
+    count-=(int) project->files().size();
+  }
+
+  _dependencyGraph.build(_projects);
+
+  event.argument(L"projectFiles",(size_t) count);
+  return(count);
+}
+
+void Solution::replaceVersionVariables(const VersionInfo &versionInfo,wifstream &input,wostream &output) const
 {
   size_t
     start,
@@ -155,9 +346,9 @@ void Solution::replaceVersionVariables(const VersionInfo &versionInfo,wifstream
 
   while (getline(input,line))
   {
-    line=replace(line,L"@CC@",_wizard.visualStudioVersionName());
-    line=replace(line,L"@CHANNEL_MASK_DEPTH@",_wizard.channelMaskDepth());
-    line=replace(line,L"@CXX@",_wizard.visualStudioVersionName());
+    line=replace(line,L"@CC@",_options.visualStudioVersionName());
+    line=replace(line,L"@CHANNEL_MASK_DEPTH@",_options.channelMaskDepth());
+    line=replace(line,L"@CXX@",_options.visualStudioVersionName());
     line=replace(line,L"@DOCUMENTATION_PATH@",L"unavailable");
     line=replace(line,L"@LIB_VERSION@",versionInfo.version());
     line=replace(line,L"@MAGICK_GIT_REVISION@",versionInfo.gitRevision());
@@ -165,7 +356,7 @@ void Solution::replaceVersionVariables(const VersionInfo &versionInfo,wifstream
     line=replace(line,L"@MAGICK_LIB_VERSION_TEXT@",versionInfo.version());
     line=replace(line,L"@MAGICK_LIBRARY_CURRENT@",versionInfo.interfaceVersion());
     line=replace(line,L"@MAGICK_LIBRARY_CURRENT_MIN@",versionInfo.interfaceVersion());
-    line=replace(line,L"@MAGICK_TARGET_CPU@",_wizard.platformAlias());
+    line=replace(line,L"@MAGICK_TARGET_CPU@",_options.platformAlias());
     line=replace(line,L"@MAGICK_TARGET_OS@",L"Windows");
     line=replace(line,L"@MAGICKPP_LIB_VERSION_TEXT@",versionInfo.version());
     line=replace(line,L"@MAGICKPP_LIBRARY_CURRENT@",versionInfo.ppInterfaceVersion());
@@ -179,7 +370,7 @@ void Solution::replaceVersionVariables(const VersionInfo &versionInfo,wifstream
     line=replace(line,L"@PACKAGE_NAME@",L"ImageMagick");
     line=replace(line,L"@PACKAGE_VERSION_ADDENDUM@",versionInfo.libAddendum());
     line=replace(line,L"@PACKAGE_RELEASE_DATE@",versionInfo.releaseDate());
-    line=replace(line,L"@QUANTUM_DEPTH@",_wizard.quantumDepthBits());
+    line=replace(line,L"@QUANTUM_DEPTH@",_options.quantumDepthBits());
     line=replace(line,L"@RELEASE_DATE@",versionInfo.releaseDate());
     line=replace(line,L"@TARGET_OS@",L"Windows");
     start=line.find(L"@");
@@ -194,32 +385,100 @@ void Solution::replaceVersionVariables(const VersionInfo &versionInfo,wifstream
   }
 }
 
-void Solution::writeInstallerConfig(const VersionInfo &versionInfo) const
+void Solution::writeCodersList() const
 {
   wifstream
     inputStream;
 
-  wofstream
+  wstringstream
     outputStream;
 
-  inputStream.open(pathFromRoot(L"Installer\\Inno\\config.isx.in"));
+  wstring
+    fileName,
+    format,
+    line;
+
+  TraceEvent
+    event(_trace,L"phase",L"Write coders-list.h");
+
+  fileName=pathFromRoot(L"ImageMagick\\coders\\coders-list.h");
+  inputStream.open(nativePath(fileName));
   if (!inputStream)
-    throwException(L"Unable to open installer config input file");
+    return;
 
-  outputStream.open(pathFromRoot(L"Installer\\Inno\\config.isx"));;
-  if (!outputStream)
+  // Only the selected coders are registered by static.c when the list in the include folder is used.
+  while (getline(inputStream,line))
+  {
+    format=trim(line);
+    if ((format.find(L"AddMagickCoder(") == 0) && endsWith(format,L")"))
     {
-      inputStream.close();
-      throwException(L"Unable to open installer config output file");
+      format=format.substr(15,format.length()-16);
+      if (!contains(_options.formats(),toLower(format)))
+        continue;
     }
 
+    outputStream << line << endl;
+  }
+
+  inputStream.close();
+
+  fileName=pathFromRoot(_options.solutionName() + L".Projects\\Include\\coders\\coders-list.h");
+  filesystem::create_directories(nativePath(fileName).parent_path());
+  _outputWriter.write(fileName,outputStream.str());
+}
+
+void Solution::writeCompilationDatabase() const
+{
+  CompilationDatabase
+    compilationDatabase(_options,_dependencyGraph);
+
+  wstringstream
+    file;
+
+  TraceEvent
+    event(_trace,L"phase",L"Write compilation database");
+
+  // The source files are only known after the project files have been written.
+  compilationDatabase.write(file);
+  filesystem::create_directories(nativePath(compilationDatabase.fileName()).parent_path());
+  _outputWriter.write(compilationDatabase.fileName(),file.str());
+}
+
+void Solution::writeCriticalPath() const
+{
+  wstringstream
+    report;
+
+  TraceEvent
+    event(_trace,L"phase",L"Write critical path");
+
+  // The source files are only known after the project files have been written.
+  CriticalPath(_dependencyGraph).write(report,_options.solutionName() + L"." + _options.platformAlias(),10);
+  _outputWriter.write(_options.criticalPathFile(),report.str());
+}
+
+void Solution::writeInstallerConfig(const VersionInfo &versionInfo) const
+{
+  wifstream
+    inputStream;
+
+  wstringstream
+    outputStream;
+
+  TraceEvent
+    event(_trace,L"phase",L"Write installer config");
+
+  inputStream.open(nativePath(pathFromRoot(L"Installer\\Inno\\config.isx.in")));
+  if (!inputStream)
+    throwException(L"Unable to open installer config input file");
+
   replaceVersionVariables(versionInfo,inputStream,outputStream);
 
-  switch (_wizard.solutionType())
+  switch (_options.solutionType())
   {
     case SolutionType::DYNAMIC_MT:
       outputStream << L"#define public MagickDynamicPackage 1" << endl;
-      if (_wizard.platform() != Platform::ARM64)
+      if (_options.platform() != Platform::ARM64)
         outputStream << L"#define public MagickPerlMagick 1" << endl;
       break;
     case SolutionType::STATIC_MT:
@@ -228,7 +487,7 @@ void Solution::writeInstallerConfig(const VersionInfo &versionInfo) const
       break;
   }
 
-  switch (_wizard.platform())
+  switch (_options.platform())
   {
     case Platform::ARM64:
       outputStream << L"#define public MagickArm64Architecture 1" << endl;
@@ -238,14 +497,15 @@ void Solution::writeInstallerConfig(const VersionInfo &versionInfo) const
       break;
   }
 
-  if (_wizard.useHDRI())
+  if (_options.useHDRI())
       outputStream << L"#define public MagickHDRI 1" << endl;
 
-  if (_wizard.isImageMagick7())
+  if (_options.isImageMagick7())
     outputStream << L"#define public MagickVersion7 1" << endl;
 
   inputStream.close();
-  outputStream.close();
+
+  _outputWriter.write(pathFromRoot(L"Installer\\Inno\\config.isx"),outputStream.str());
 }
 
 void Solution::writeMagickBaseConfig() const
@@ -257,20 +517,20 @@ void Solution::writeMagickBaseConfig() const
   wifstream
     configIn;
 
-  wofstream
+  wstringstream
     config;
 
   wstring
     folderName;
 
-  configIn.open(pathFromRoot(L"Projects\\MagickCore\\magick-baseconfig.h.in"));
+  TraceEvent
+    event(_trace,L"phase",L"Write magick-baseconfig.h");
+
+  configIn.open(nativePath(pathFromRoot(L"Projects\\MagickCore\\magick-baseconfig.h.in")));
   if (!configIn)
     return;
 
-  folderName=_wizard.magickCoreProjectName();
-  config.open(pathFromRoot(L"ImageMagick\\" + folderName + L"\\magick-baseconfig.h"));
-  if (!config)
-    return;
+  folderName=_options.magickCoreProjectName();
 
   while (getline(configIn,line))
   {
@@ -288,7 +548,7 @@ void Solution::writeMagickBaseConfig() const
     config << "  the built ImageMagick to any directory on any directory on any machine," << endl;
     config << "  then do not use this setting." << endl;
     config << "*/" << endl;
-    if (_wizard.installedSupport())
+    if (_options.installedSupport())
       config << "#define MAGICKCORE_INSTALLED_SUPPORT" << endl;
     else
       config << "#undef MAGICKCORE_INSTALLED_SUPPORT" << endl;
@@ -299,29 +559,29 @@ void Solution::writeMagickBaseConfig() const
     config << "  A value of 8 uses half the memory than 16 and typically runs 30% faster," << endl;
     config << "  but provides 256 times less color resolution than a value of 16." << endl;
     config << "*/" << endl;
-    if (_wizard.quantumDepth() == QuantumDepth::Q8)
+    if (_options.quantumDepth() == QuantumDepth::Q8)
       config << "#define MAGICKCORE_QUANTUM_DEPTH 8" << endl;
-    else if (_wizard.quantumDepth() == QuantumDepth::Q16)
+    else if (_options.quantumDepth() == QuantumDepth::Q16)
       config << "#define MAGICKCORE_QUANTUM_DEPTH 16" << endl;
-    else if (_wizard.quantumDepth() == QuantumDepth::Q32)
+    else if (_options.quantumDepth() == QuantumDepth::Q32)
       config << "#define MAGICKCORE_QUANTUM_DEPTH 32" << endl;
-    else if (_wizard.quantumDepth() == QuantumDepth::Q64)
+    else if (_options.quantumDepth() == QuantumDepth::Q64)
       config << "#define MAGICKCORE_QUANTUM_DEPTH 64" << endl;
     config << endl;
 
-    if (_wizard.channelMaskDepth() != L"")
+    if (_options.channelMaskDepth() != L"")
       {
         config << "/*" << endl;
         config << "  Channel mask depth" << endl;
         config << "*/" << endl;
-        config << "#define MAGICKCORE_CHANNEL_MASK_DEPTH " << _wizard.channelMaskDepth() << endl;
+        config << "#define MAGICKCORE_CHANNEL_MASK_DEPTH " << _options.channelMaskDepth() << endl;
         config << endl;
       }
 
     config << "/*" << endl;
     config << "  Define to enable high dynamic range imagery (HDRI)" << endl;
     config << "*/" << endl;
-    if (_wizard.useHDRI())
+    if (_options.useHDRI())
       config << "#define MAGICKCORE_HDRI_ENABLE 1" << endl;
     else
       config << "#define MAGICKCORE_HDRI_ENABLE 0" << endl;
@@ -330,7 +590,7 @@ void Solution::writeMagickBaseConfig() const
     config << "/*" << endl;
     config << "  Define to enable OpenCL" << endl;
     config << "*/" << endl;
-    if (_wizard.useOpenCL())
+    if (_options.useOpenCL())
       config << "#define MAGICKCORE_HAVE_CL_CL_H" << endl;
     else
       config << "#undef MAGICKCORE_HAVE_CL_CL_H" << endl;
@@ -339,7 +599,7 @@ void Solution::writeMagickBaseConfig() const
     config << "/*" << endl;
     config << "  Define to enable Distributed Pixel Cache" << endl;
     config << "*/" << endl;
-    if (_wizard.enableDpc())
+    if (_options.enableDpc())
       config << "#define MAGICKCORE_DPC_SUPPORT" << endl;
     else
       config << "#undef MAGICKCORE_DPC_SUPPORT" << endl;
@@ -348,7 +608,7 @@ void Solution::writeMagickBaseConfig() const
     config << "/*" << endl;
     config << "  Exclude deprecated methods in MagickCore API" << endl;
     config << "*/" << endl;
-    if (_wizard.excludeDeprecated())
+    if (_options.excludeDeprecated())
       config << "#define MAGICKCORE_EXCLUDE_DEPRECATED" << endl;
     else
       config << "#undef MAGICKCORE_EXCLUDE_DEPRECATED" << endl;
@@ -357,7 +617,7 @@ void Solution::writeMagickBaseConfig() const
     config << "/*" << endl;
     config << "  Define to only use the built-in (in-memory) settings." << endl;
     config << "*/" << endl;
-    if (_wizard.zeroConfigurationSupport())
+    if (_options.zeroConfigurationSupport())
       config << "#define MAGICKCORE_ZERO_CONFIGURATION_SUPPORT 1" << endl;
     else
       config << "#define MAGICKCORE_ZERO_CONFIGURATION_SUPPORT 0" << endl;
@@ -374,64 +634,89 @@ void Solution::writeMagickBaseConfig() const
       config << project->configDefine();
     }
   }
+
+  configIn.close();
+
+  _outputWriter.write(pathFromRoot(L"ImageMagick\\" + folderName + L"\\magick-baseconfig.h"),config.str());
+
+  // The variants can be built next to each other because every solution also gets its own copy.
+  if (_options.shareDependencies())
+  {
+    filesystem::create_directories(nativePath(pathFromRoot(_options.solutionName() + L".Projects\\Include\\" + folderName)));
+    _outputWriter.write(pathFromRoot(_options.solutionName() + L".Projects\\Include\\" + folderName + L"\\magick-baseconfig.h"),config.str());
+  }
 }
 
 void Solution::writeMakeFile() const
 {
   wifstream
-    makeFileIn,
-    zipIn;
+    makeFileIn;
 
-  wofstream
-    lib,
-    makeFile,
-    zip;
+  wstringstream
+    makeFile;
 
   wstring
     libName,
     line;
 
-  libName=L"CORE_RL_" + _wizard.magickCoreProjectName()+ L"_";
+  TraceEvent
+    event(_trace,L"phase",L"Write Makefile.PL");
 
-  lib=wofstream(pathFromRoot(L"ImageMagick\\PerlMagick\\" + libName + L".a"));
-  if (!lib)
+  if (!filesystem::is_directory(nativePath(pathFromRoot(L"ImageMagick\\PerlMagick"))))
     return;
 
-  lib.close();
+  libName=L"CORE_RL_" + _options.magickCoreProjectName()+ L"_";
+
+  _outputWriter.write(pathFromRoot(L"ImageMagick\\PerlMagick\\" + libName + L".a"),L"");
 
-  zipIn=wifstream(pathFromRoot(L"Projects\\PerlMagick\\Zip.ps1"), std::ios::binary);
-  if (!zipIn)
+  if (!filesystem::exists(nativePath(pathFromRoot(L"Projects\\PerlMagick\\Zip.ps1"))))
     return;
 
-  zip=wofstream(pathFromRoot(L"ImageMagick\\PerlMagick\\Zip.ps1"), std::ios::binary);
-  zip << zipIn.rdbuf();
-  zip.close();
+  _outputWriter.copy(pathFromRoot(L"Projects\\PerlMagick\\Zip.ps1"),pathFromRoot(L"ImageMagick\\PerlMagick\\Zip.ps1"));
 
-  makeFileIn.open(pathFromRoot(L"Projects\\PerlMagick\\Makefile.PL.in"));
+  makeFileIn.open(nativePath(pathFromRoot(L"Projects\\PerlMagick\\Makefile.PL.in")));
   if (!makeFileIn)
     return;
 
-  makeFile.open(pathFromRoot(L"ImageMagick\\PerlMagick\\Makefile.PL"));
-  if (!makeFile)
-    return;
-
   while (getline(makeFileIn,line))
   {
     line=replace(line,L"$$LIB_NAME$$",libName);
-    line=replace(line,L"$$PLATFORM$$",_wizard.platformAlias());
+    line=replace(line,L"$$PLATFORM$$",_options.platformAlias());
     makeFile << line << endl;
   }
-  makeFile.close();
+  makeFileIn.close();
+
+  _outputWriter.write(pathFromRoot(L"ImageMagick\\PerlMagick\\Makefile.PL"),makeFile.str());
+}
+
+void Solution::writeNinjaFile() const
+{
+  NinjaFile
+    ninjaFile(_options,_dependencyGraph);
+
+  wstringstream
+    file;
+
+  TraceEvent
+    event(_trace,L"phase",L"Write ninja file");
+
+  // The source files are only known after the project files have been written.
+  ninjaFile.write(file);
+  _outputWriter.write(ninjaFile.fileName(),file.str());
 }
 
 void Solution::writeNotice(const VersionInfo &versionInfo) const
 {
-  wofstream
+  size_t
+    count;
+
+  wstringstream
     notice;
 
-  notice.open(pathFromRoot(L"Artifacts\\NOTICE.txt"));
-  if (!notice)
-    return;
+  TraceEvent
+    event(_trace,L"phase",L"Write NOTICE.txt");
+
+  count=0;
 
   notice << "* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
   notice << "[ Imagemagick " << versionInfo.version() << versionInfo.libAddendum() << "] copyright:" << endl << endl;
@@ -445,9 +730,170 @@ void Solution::writeNotice(const VersionInfo &versionInfo) const
 
     notice << project->notice();
     notice << "* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+    count++;
+  }
+
+  _outputWriter.write(pathFromRoot(L"Artifacts\\NOTICE.txt"),notice.str());
+
+  event.argument(L"notices",count);
+}
+
+void Solution::writeProjectFiles(Progress &progress) const
+{
+  atomic<bool>
+    failed;
+
+  atomic<size_t>
+    next,
+    written;
+
+  exception_ptr
+    error;
+
+  mutex
+    errorLock;
+
+  size_t
+    reported,
+    threadCount;
+
+  vector<ProjectFile*>
+    projectFiles;
+
+  vector<thread>
+    threads;
+
+  TraceEvent
+    event(_trace,L"phase",L"Write project files");
+
+  for (auto& project : _projects)
+  {
+    for (auto& projectFile : project->files())
+      projectFiles.push_back(projectFile);
+  }
+
+  // The fingerprints include the fingerprints of the references, this cannot be done by the workers.
+  if (!_options.libraryCacheDirectory().empty())
+    loadLibraryCache();
+
+  threadCount=min((size_t) _options.threadCount(),projectFiles.size());
+  event.argument(L"projectFiles",projectFiles.size());
+  event.argument(L"threads",threadCount);
+  if (threadCount <= 1)
+  {
+    for (auto& projectFile : projectFiles)
+    {
+      progress.nextStep(L"Writing: " + projectFile->fileName());
+      projectFile->write(_dependencyGraph,_outputWriter);
+    }
+    return;
+  }
+
+  // The project folders share a parent, create it before the workers race for it.
+  filesystem::create_directories(nativePath(pathFromRoot(_options.solutionName() + L".Projects")));
+  filesystem::create_directories(nativePath(pathFromRoot(_options.sharedSolutionName() + L".Projects")));
+
+  failed=false;
+  next=0;
+  written=0;
+  for (size_t i=0; i < threadCount; i++)
+  {
+    threads.push_back(thread([&]()
+    {
+      size_t
+        index;
+
+      while ((index=next++) < projectFiles.size())
+      {
+        try
+        {
+          projectFiles[index]->write(_dependencyGraph,_outputWriter);
+        }
+        catch (...)
+        {
+          lock_guard<mutex> lock(errorLock);
+          if (!error)
+            error=current_exception();
+          failed=true;
+          next=projectFiles.size();
+        }
+        written++;
+      }
+    }));
   }
 
-  notice.close();
+  // The dialog can only be updated from this thread, it follows the counter of the workers.
+  reported=0;
+  while (reported < projectFiles.size())
+  {
+    if (reported < written)
+      progress.nextStep(L"Writing: " + projectFiles[reported++]->fileName());
+    else if (failed)
+      break;
+    else
+      this_thread::sleep_for(chrono::milliseconds(10));
+  }
+
+  // The exception is only read after the workers are finished with it.
+  for (auto& t : threads)
+    t.join();
+
+  if (error)
+    rethrow_exception(error);
+}
+
+void Solution::writeSolutionFilter(const SolutionFilter &solutionFilter) const
+{
+  wstringstream
+    file;
+
+  wstring
+    solutionFileName;
+
+  if (solutionFilter.empty())
+    return;
+
+  solutionFileName=getFileName();
+  solutionFileName=solutionFileName.substr(solutionFileName.find_last_of(L"\\") + 1);
+  solutionFilter.write(file,solutionFileName);
+  _outputWriter.write(solutionFilter.fileName(),file.str());
+}
+
+void Solution::writeSolutionFilters() const
+{
+  const Project
+    *magickCore;
+
+  TraceEvent
+    event(_trace,L"phase",L"Write solution filters");
+
+  SolutionFilter
+    applications(_options,_dependencyGraph,L"Applications"),
+    core(_options,_dependencyGraph,L"Core"),
+    fuzz(_options,_dependencyGraph,L"Fuzz");
+
+  magickCore=_dependencyGraph.find(_options.magickCoreProjectName());
+  if (magickCore != (const Project *) NULL)
+  {
+    for (auto& projectFile : magickCore->files())
+      core.add(projectFile);
+  }
+  writeSolutionFilter(core);
+
+  applications.addPrefix(L"UTIL");
+  writeSolutionFilter(applications);
+
+  fuzz.addPrefix(L"FUZZ");
+  writeSolutionFilter(fuzz);
+
+  for (auto& projectName : _options.solutionFilterProjects())
+  {
+    SolutionFilter
+      solutionFilter(_options,_dependencyGraph,projectName);
+
+    solutionFilter.add(projectName);
+    writeSolutionFilter(solutionFilter);
+  }
 }
 
 void Solution::writeThresholdMap() const
@@ -455,29 +901,24 @@ void Solution::writeThresholdMap() const
   wifstream
     inputStream;
 
-  wofstream
+  wstringstream
     outputStream;
 
   wstring
     fileName,
     line;
 
-  if (!_wizard.zeroConfigurationSupport())
+  TraceEvent
+    event(_trace,L"phase",L"Write threshold-map.h");
+
+  if (!_options.zeroConfigurationSupport())
     return;
 
-  fileName=pathFromRoot(_wizard.binDirectory() + L"thresholds.xml");
-  inputStream.open(fileName);
+  fileName=pathFromRoot(_options.binDirectory(L"Release") + L"thresholds.xml");
+  inputStream.open(nativePath(fileName));
   if (!inputStream)
     throwException(L"Unable to open:" + fileName);
 
-  fileName=pathFromRoot(L"ImageMagick\\" + _wizard.magickCoreProjectName() + L"\\threshold-map.h");
-  outputStream.open(fileName);
-  if (!outputStream)
-    {
-      inputStream.close();
-      throwException(L"Unable to open:" + fileName);
-    }
-
   outputStream << "static const char *const BuiltinMap=" << endl;
 
   while (getline(inputStream,line))
@@ -492,7 +933,54 @@ void Solution::writeThresholdMap() const
   outputStream << ";";
 
   inputStream.close();
-  outputStream.close();
+
+  fileName=pathFromRoot(L"ImageMagick\\" + _options.magickCoreProjectName() + L"\\threshold-map.h");
+  _outputWriter.write(fileName,outputStream.str());
+}
+
+void Solution::writeTrainingProject() const
+{
+  TrainingProject
+    trainingProject(_options);
+
+  vector<wstring>
+    formats;
+
+  vector<ProjectFile*>
+    references;
+
+  wstring
+    format;
+
+  TraceEvent
+    event(_trace,L"phase",L"Write training project");
+
+  // The training runs the executables and the coders they load, these have to be built first.
+  for (auto& project : _projects)
+  {
+    for (auto& projectFile : project->files())
+    {
+      if (project->isExe() || (project->isDll() && _options.solutionType() == SolutionType::DYNAMIC_MT))
+        references.push_back(projectFile);
+
+      if (project->name() != L"coders")
+        continue;
+
+      for (auto& sourceFile : projectFile->sourceFiles())
+      {
+        format=sourceFile.substr(sourceFile.find_last_of(L"\\") + 1);
+        format=format.substr(0,format.find_last_of(L"."));
+        if (!contains(formats,format))
+          formats.push_back(format);
+      }
+    }
+  }
+  sort(formats.begin(),formats.end());
+
+  trainingProject.write(references,formats,_outputWriter);
+
+  event.argument(L"references",references.size());
+  event.argument(L"formats",formats.size());
 }
 
 void Solution::writeVersion(const VersionInfo &versionInfo) const
@@ -501,11 +989,17 @@ void Solution::writeVersion(const VersionInfo &versionInfo) const
     folderName,
     line;
 
-  folderName=_wizard.magickCoreProjectName();
+  TraceEvent
+    event(_trace,L"phase",L"Write version");
+
+  folderName=_options.magickCoreProjectName();
   writeVersion(versionInfo,pathFromRoot(L"ImageMagick\\" + folderName + L"\\version.h.in"),pathFromRoot(L"ImageMagick\\" + folderName + L"\\version.h"));
-  filesystem::copy_file(pathFromRoot(L"ImageMagick\\" + folderName + L"\\version.h"),pathFromRoot(L"Build\\version.h"),filesystem::copy_options::overwrite_existing);
+  _outputWriter.copy(pathFromRoot(L"ImageMagick\\" + folderName + L"\\version.h"),pathFromRoot(L"Build\\version.h"));
+  if (_options.shareDependencies())
+    _outputWriter.copy(pathFromRoot(L"ImageMagick\\" + folderName + L"\\version.h"),pathFromRoot(_options.solutionName() + L".Projects\\Include\\" + folderName + L"\\version.h"));
   writeVersion(versionInfo,pathFromRoot(L"Build\\package.version.h.in"),pathFromRoot(L"Build\\package.version.h"));
-  writeVersion(versionInfo,pathFromRoot(L"ImageMagick\\config\\configure.xml.in"),pathFromRoot(_wizard.binDirectory() + L"configure.xml"));
+  for (auto& binDirectory : _options.binDirectories())
+    writeVersion(versionInfo,pathFromRoot(L"ImageMagick\\config\\configure.xml.in"),pathFromRoot(binDirectory + L"configure.xml"));
 }
 
 void Solution::writeVersion(const VersionInfo &versionInfo,const wstring &input,const wstring &output) const
@@ -513,31 +1007,25 @@ void Solution::writeVersion(const VersionInfo &versionInfo,const wstring &input,
   wifstream
     inputStream;
 
-  wofstream
+  wstringstream
     outputStream;
 
-  inputStream.open(input);
+  inputStream.open(nativePath(input));
   if (!inputStream)
     throwException(L"Unable to open: " + input);
 
-  outputStream.open(output);
-  if (!outputStream)
-    {
-      inputStream.close();
-      throwException(L"Unable to open: " + output);
-    }
-
   replaceVersionVariables(versionInfo,inputStream,outputStream);
 
   inputStream.close();
-  outputStream.close();
+
+  _outputWriter.write(output,outputStream.str());
 }
 
-void Solution::addConfigFolder(wofstream &file) const
+void Solution::addConfigFolder(wostream &file) const
 {
   file << "Project(\"{2150E333-8FDC-42A3-9474-1A3956D46DE8}\") = \"Config\", \"Config\", \"{" << createGuid(L"Config") << "}\"" << endl;
   file << "\tProjectSection(SolutionItems) = preProject" << endl;
-  for (const auto& entry : filesystem::directory_iterator(pathFromRoot(L"Artifacts\\bin")))
+  for (const auto& entry : filesystem::directory_iterator(nativePath(pathFromRoot(_options.binDirectory(L"Release")))))
   {
     wstring
       fileName;
@@ -545,18 +1033,18 @@ void Solution::addConfigFolder(wofstream &file) const
     if (!entry.is_regular_file())
       continue;
 
-    fileName = entry.path().filename();
+    fileName = entry.path().filename().wstring();
     if (!endsWith(fileName, L".xml"))
       continue;
 
-    file << "\t\tArtifacts\\bin\\" << fileName << " = Artifacts\\bin\\" << fileName << endl;
+    file << "\t\t" << _options.binDirectory(L"Release") << fileName << " = " << _options.binDirectory(L"Release") << fileName << endl;
   }
   file << "\tEndProjectSection" << endl;
   file << "EndProject" << endl;
   return;
 }
 
-void Solution::addNestedProjects(wofstream &file,const wstring &name,const wstring &prefix) const
+void Solution::addNestedProjects(wostream &file,const wstring &name,const wstring &prefix) const
 {
   wstring
     guid;
@@ -574,7 +1062,7 @@ void Solution::addNestedProjects(wofstream &file,const wstring &name,const wstri
   }
 }
 
-void Solution::addProjects(wofstream &file,const wstring &prefix) const
+void Solution::addProjects(wostream &file,const wstring &prefix) const
 {
   for (auto& project : _projects)
   {
@@ -583,14 +1071,14 @@ void Solution::addProjects(wofstream &file,const wstring &prefix) const
       if (startsWith(projectFile->name(),prefix))
         {
           file << "Project(\"{8BC9CEB8-8B4A-11D0-8D11-00A0C91BC942}\") = \"" << projectFile->name() << "\", ";
-          file << "\"" << _wizard.solutionName() << ".Projects\\" << projectFile->name() << "\\" << projectFile->fileName() << "\", \"{" << projectFile->guid() << "}\"" << endl;
+          file << "\"" << projectFile->projectDirectory() << "\\" << projectFile->fileName() << "\", \"{" << projectFile->guid() << "}\"" << endl;
           file << "EndProject" << endl;
         }
     }
   }
 }
 
-void Solution::addSolutionFolder(wofstream &file,const wstring &name,const wstring &prefix) const
+void Solution::addSolutionFolder(wostream &file,const wstring &name,const wstring &prefix) const
 {
   for (auto& project : _projects)
   {
@@ -608,15 +1096,15 @@ void Solution::addSolutionFolder(wofstream &file,const wstring &name,const wstri
 
 void Solution::checkKeyword(const wstring keyword) const
 {
-  vector<wstring> skipableKeywords={
+  static const FileMatcher skipableKeywords({
     L"CODER_PATH",L"CONFIGURE_ARGS",L"CONFIGURE_PATH",L"CXXFLAGS",L"DEFS",L"DISTCHECK_CONFIG_FLAGS",
     L"EXEC_PREFIX_DIR",L"EXECUTABLE_PATH",L"FILTER_PATH",L"host",L"INCLUDE_PATH",L"LIBRARY_ABSOLUTE_PATH",
     L"MAGICK_CFLAGS",L"MAGICK_CPPFLAGS",L"MAGICK_DELEGATES",L"MAGICK_FEATURES",L"MAGICK_LDFLAGS",
     L"MAGICK_LIBS",L"MAGICK_PCFLAGS",L"MAGICK_SECURITY_POLICY",L"MAGICK_TARGET_VENDOR",L"PREFIX_DIR",
     L"SHARE_PATH",L"SHAREARCH_PATH"
-  };
+  });
 
-  if (contains(skipableKeywords,keyword))
+  if (skipableKeywords.matches(keyword))
     return;
 
   throwException(L"Invalid keyword: " + keyword);
@@ -630,7 +1118,12 @@ void Solution::createConfigFiles() const
   vector<wstring>
     xmlFiles = { L"colors.xml", L"english.xml", L"locale.xml", L"log.xml", L"thresholds.xml" };
 
-  switch(_wizard.policyConfig())
+  TraceEvent
+    event(_trace,L"phase",L"Copy config files");
+
+  event.argument(L"files",xmlFiles.size()+1);
+
+  switch(_options.policyConfig())
   {
     case PolicyConfig::LIMITED:
       policyXml=pathFromRoot(L"ImageMagick\\config\\policy-limited.xml");
@@ -645,23 +1138,34 @@ void Solution::createConfigFiles() const
       policyXml=pathFromRoot(L"ImageMagick\\config\\policy-websafe.xml");
       break;
   }
-  if (!filesystem::exists(policyXml))
+  if (!filesystem::exists(nativePath(policyXml)))
     throwException(L"Unable to open policy file");
-  filesystem::copy_file(policyXml,pathFromRoot(_wizard.binDirectory() + L"policy.xml"),filesystem::copy_options::overwrite_existing);
-  for (auto& xmlFile : xmlFiles)
+  // The profile guided configurations have their own folder and the training needs the config files too.
+  for (auto& binDirectory : _options.binDirectories())
   {
-    filesystem::copy_file(pathFromRoot(L"ImageMagick\\config\\" + xmlFile),pathFromRoot(_wizard.binDirectory() + xmlFile),filesystem::copy_options::overwrite_existing);
-  }  
+    filesystem::create_directories(nativePath(pathFromRoot(binDirectory)));
+    _outputWriter.copy(policyXml,pathFromRoot(binDirectory + L"policy.xml"));
+    for (auto& xmlFile : xmlFiles)
+    {
+      _outputWriter.copy(pathFromRoot(L"ImageMagick\\config\\" + xmlFile),pathFromRoot(binDirectory + xmlFile));
+    }
+  }
 }
 
-void Solution::write(wofstream &file) const
+void Solution::write(wostream &file) const
 {
+  TrainingProject
+    trainingProject(_options);
+
+  TraceEvent
+    event(_trace,L"phase",L"Write solution");
+
   file << "Microsoft Visual Studio Solution File, Format Version 12.00" << endl;
-  if (_wizard.visualStudioVersion() == VisualStudioVersion::VS2017)
+  if (_options.visualStudioVersion() == VisualStudioVersion::VS2017)
     file << "# Visual Studio 2017" << endl;
-  else if (_wizard.visualStudioVersion() == VisualStudioVersion::VS2019)
+  else if (_options.visualStudioVersion() == VisualStudioVersion::VS2019)
     file << "# Visual Studio 2019" << endl;
-  else if (_wizard.visualStudioVersion() == VisualStudioVersion::VS2022)
+  else if (_options.visualStudioVersion() == VisualStudioVersion::VS2022)
     file << "# Visual Studio 2022" << endl;
 
   addProjects(file,L"UTIL");
@@ -670,6 +1174,12 @@ void Solution::write(wofstream &file) const
   addProjects(file,L"FILTER");
   addProjects(file,L"FUZZ");
   addProjects(file,L"IM_MOD");
+  if (_options.profileGuidedOptimization())
+  {
+    file << "Project(\"{8BC9CEB8-8B4A-11D0-8D11-00A0C91BC942}\") = \"" << trainingProject.name() << "\", ";
+    file << "\"" << _options.solutionName() << ".Projects\\" << trainingProject.name() << "\\" << trainingProject.fileName() << "\", \"{" << trainingProject.guid() << "}\"" << endl;
+    file << "EndProject" << endl;
+  }
 
   addSolutionFolder(file,L"Applications",L"UTIL");
   addConfigFolder(file);
@@ -681,8 +1191,8 @@ void Solution::write(wofstream &file) const
 
   file << "Global" << endl;
   file << "\tGlobalSection(SolutionConfigurationPlatforms) = preSolution" << endl;
-  file << "\t\tDebug|" << _wizard.platformAlias() << " = Debug|" << _wizard.platformAlias() << endl;
-  file << "\t\tRelease|" << _wizard.platformAlias() << " = Release|" << _wizard.platformAlias() << endl;
+  for (auto& configuration : _options.configurations())
+    file << "\t\t" << configuration << "|" << _options.platformAlias() << " = " << configuration << "|" << _options.platformAlias() << endl;
   file << "\tEndGlobalSection" << endl;
 
   file << "\tGlobalSection(ProjectConfigurationPlatforms) = postSolution" << endl;
@@ -690,10 +1200,21 @@ void Solution::write(wofstream &file) const
   {
     for (auto& projectFile : project->files())
     {
-      file << "\t\t{" << projectFile->guid() << "}.Debug|" << _wizard.platformAlias() << ".ActiveCfg = Debug|" << _wizard.platformName() << endl;
-      file << "\t\t{" << projectFile->guid() << "}.Debug|" << _wizard.platformAlias() << ".Build.0 = Debug|" << _wizard.platformName() << endl;
-      file << "\t\t{" << projectFile->guid() << "}.Release|" << _wizard.platformAlias() << ".ActiveCfg = Release|" << _wizard.platformName() << endl;
-      file << "\t\t{" << projectFile->guid() << "}.Release|" << _wizard.platformAlias() << ".Build.0 = Release|" << _wizard.platformName() << endl;
+      for (auto& configuration : _options.configurations())
+      {
+        file << "\t\t{" << projectFile->guid() << "}." << configuration << "|" << _options.platformAlias() << ".ActiveCfg = " << configuration << "|" << _options.platformName() << endl;
+        file << "\t\t{" << projectFile->guid() << "}." << configuration << "|" << _options.platformAlias() << ".Build.0 = " << configuration << "|" << _options.platformName() << endl;
+      }
+    }
+  }
+  // The training project only exists in the PGInstrument configuration and is only built there.
+  if (_options.profileGuidedOptimization())
+  {
+    for (auto& configuration : _options.configurations())
+    {
+      file << "\t\t{" << trainingProject.guid() << "}." << configuration << "|" << _options.platformAlias() << ".ActiveCfg = PGInstrument|" << _options.platformName() << endl;
+      if (configuration == L"PGInstrument")
+        file << "\t\t{" << trainingProject.guid() << "}." << configuration << "|" << _options.platformAlias() << ".Build.0 = PGInstrument|" << _options.platformName() << endl;
     }
   }
   file << "\tEndGlobalSection" << endl;
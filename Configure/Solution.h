@@ -20,31 +20,49 @@
 #ifndef __Solution__
 #define __Solution__
 
+#include "DependencyGraph.h"
+#include "Options.h"
+#include "OutputWriter.h"
+#include "Progress.h"
 #include "Project.h"
-#include "ConfigureWizard.h"
+#include "SolutionFilter.h"
+#include "Trace.h"
 #include "VersionInfo.h"
-#include "WaitDialog.h"
 
 class Solution
 {
 public:
-  Solution(const ConfigureWizard &wizard);
+  Solution(const Options &options);
+
+  const ConfigCache &configCache() const;
+
+  const DependencyGraph &dependencyGraph() const;
+
+  const DirectoryIndex &directoryIndex() const;
+
+  const OutputWriter &outputWriter() const;
 
   int loadProjectFiles() const;
 
+  long long loadTime() const;
+
   void loadProjects();
 
-  void write(WaitDialog &waitDialog) const;
+  void printStatistics(ostream &stream) const;
+
+  const Trace &trace() const;
+
+  void write(Progress &progress) const;
 
 private:
 
-  void addConfigFolder(wofstream &file) const;
+  void addConfigFolder(wostream &file) const;
 
-  void addNestedProjects(wofstream &file,const wstring &name,const wstring &prefix) const;
+  void addNestedProjects(wostream &file,const wstring &name,const wstring &prefix) const;
 
-  void addProjects(wofstream &file,const wstring &prefix) const;
+  void addProjects(wostream &file,const wstring &prefix) const;
 
-  void addSolutionFolder(wofstream &file,const wstring &name,const wstring &prefix) const;
+  void addSolutionFolder(wostream &file,const wstring &name,const wstring &prefix) const;
 
   void checkKeyword(const wstring keyword) const;
 
@@ -52,9 +70,19 @@ private:
 
   const wstring getFileName() const;
 
+  void loadLibraryCache() const;
+
   void loadProjectsFromFolder(const wstring &folder,const wstring &filesFolder);
 
-  void replaceVersionVariables(const VersionInfo &versionInfo,wifstream &input,wofstream &output) const;
+  int removeUnusedDependencies() const;
+
+  void replaceVersionVariables(const VersionInfo &versionInfo,wifstream &input,wostream &output) const;
+
+  void writeCodersList() const;
+
+  void writeCompilationDatabase() const;
+
+  void writeCriticalPath() const;
 
   void writeInstallerConfig(const VersionInfo &versionInfo) const;
 
@@ -62,18 +90,34 @@ private:
 
   void writeMakeFile() const;
 
+  void writeNinjaFile() const;
+
   void writeNotice(const VersionInfo &versionInfo) const;
 
+  void writeProjectFiles(Progress &progress) const;
+
+  void writeSolutionFilter(const SolutionFilter &solutionFilter) const;
+
+  void writeSolutionFilters() const;
+
   void writeThresholdMap() const;
 
+  void writeTrainingProject() const;
+
   void writeVersion(const VersionInfo &versionInfo) const;
 
   void writeVersion(const VersionInfo &versionInfo,const wstring &input,const wstring &output) const;
 
-  void write(wofstream &file) const;
+  void write(wostream &file) const;
 
-  vector<Project*> _projects;
-  const ConfigureWizard &_wizard;
+  ConfigCache             _configCache;
+  mutable DependencyGraph _dependencyGraph;
+  DirectoryIndex          _directoryIndex;
+  mutable long long       _loadTime;
+  const Options           &_options;
+  OutputWriter            _outputWriter;
+  vector<Project*>        _projects;
+  Trace                   _trace;
 };
 
 #endif // __Solution__
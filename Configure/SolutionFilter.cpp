@@ -0,0 +1,107 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "SolutionFilter.h"
+#include "Shared.h"
+
+SolutionFilter::SolutionFilter(const Options &options,const DependencyGraph &graph,const wstring &name)
+  : _graph(graph),
+    _name(name),
+    _options(options)
+{
+}
+
+void SolutionFilter::add(const ProjectFile *projectFile)
+{
+  if (!_projectFiles.insert(projectFile).second)
+    return;
+
+  // A project can only be built when the projects that it references are also loaded.
+  for (auto& reference : _graph.references(projectFile))
+    add(reference);
+}
+
+void SolutionFilter::add(const wstring &projectName)
+{
+  bool
+    found;
+
+  found=false;
+  for (auto& projectFile : _graph.order())
+  {
+    if ((projectFile->name() == projectName) || (endsWith(projectFile->name(),L"_" + projectName)))
+    {
+      add(projectFile);
+      found=true;
+    }
+  }
+
+  if (!found)
+    throwException(L"Unable to find the project of the solution filter: " + projectName);
+}
+
+void SolutionFilter::addPrefix(const wstring &prefix)
+{
+  // The startsWith of Shared.h also matches in the middle of the name, so that cannot be used here.
+  for (auto& projectFile : _graph.order())
+  {
+    if (projectFile->name().compare(0,prefix.size()+1,prefix + L"_") == 0)
+      add(projectFile);
+  }
+}
+
+bool SolutionFilter::empty() const
+{
+  return(_projectFiles.empty());
+}
+
+const wstring SolutionFilter::fileName() const
+{
+  return(pathFromRoot(_options.solutionName() + L"." + _options.platformAlias() + L"." + _name + L".slnf"));
+}
+
+void SolutionFilter::write(wostream &file,const wstring &solutionFileName) const
+{
+  bool
+    first;
+
+  string
+    path;
+
+  first=true;
+  file << "{" << endl;
+  file << "  \"solution\": {" << endl;
+  path=jsonString(solutionFileName);
+  file << "    \"path\": " << wstring(path.begin(),path.end()) << "," << endl;
+  file << "    \"projects\": [";
+  // The order of the solution is used so the file does not change between runs.
+  for (auto& projectFile : _graph.order())
+  {
+    if (_projectFiles.find(projectFile) == _projectFiles.end())
+      continue;
+
+    path=jsonString(projectFile->projectDirectory() + L"\\" + projectFile->fileName());
+    file << (first ? "" : ",") << endl << "      " << wstring(path.begin(),path.end());
+    first=false;
+  }
+  file << endl << "    ]" << endl;
+  file << "  }" << endl;
+  file << "}" << endl;
+}
@@ -0,0 +1,51 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __SolutionFilter__
+#define __SolutionFilter__
+
+#include "DependencyGraph.h"
+#include "Options.h"
+#include <unordered_set>
+
+class SolutionFilter
+{
+public:
+  SolutionFilter(const Options &options,const DependencyGraph &graph,const wstring &name);
+
+  void add(const ProjectFile *projectFile);
+
+  void add(const wstring &projectName);
+
+  void addPrefix(const wstring &prefix);
+
+  bool empty() const;
+
+  const wstring fileName() const;
+
+  void write(wostream &file,const wstring &solutionFileName) const;
+
+private:
+  const DependencyGraph                  &_graph;
+  const wstring                          _name;
+  const Options                          &_options;
+  unordered_set<const ProjectFile*>      _projectFiles;
+};
+
+#endif // __SolutionFilter__
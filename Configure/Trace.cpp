@@ -0,0 +1,126 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "Trace.h"
+#include "Shared.h"
+
+Trace::Trace()
+{
+  _enabled=false;
+  _origin=chrono::steady_clock::now();
+}
+
+void Trace::add(const wstring &category,const wstring &name,const chrono::steady_clock::time_point &start,const string &arguments) const
+{
+  Event
+    event;
+
+  chrono::steady_clock::time_point
+    end;
+
+  end=chrono::steady_clock::now();
+  event.arguments=arguments;
+  event.category=category;
+  event.duration=chrono::duration_cast<chrono::microseconds>(end-start).count();
+  event.name=name;
+  event.start=chrono::duration_cast<chrono::microseconds>(start-_origin).count();
+
+  lock_guard<mutex> lock(_lock);
+  auto thread=_threads.insert(make_pair(this_thread::get_id(),_threads.size()+1));
+  event.thread=thread.first->second;
+  _events.push_back(event);
+}
+
+bool Trace::enabled() const
+{
+  return(_enabled);
+}
+
+void Trace::enabled(bool value)
+{
+  _enabled=value;
+}
+
+size_t Trace::eventCount() const
+{
+  lock_guard<mutex> lock(_lock);
+  return(_events.size());
+}
+
+void Trace::write(const wstring &fileName) const
+{
+  ofstream
+    file;
+
+  // The events use the trace event format of Chrome, the file can be opened with chrome://tracing or Perfetto.
+  file.open(nativePath(fileName));
+  if (!file)
+    throwException(L"Unable to open: " + fileName);
+
+  lock_guard<mutex> lock(_lock);
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (size_t i=0; i < _events.size(); i++)
+  {
+    const Event
+      &event=_events[i];
+
+    file << (i == 0 ? "" : ",") << endl;
+    file << "{\"name\":" << jsonString(event.name) << ",\"cat\":" << jsonString(event.category) << ",\"ph\":\"X\"";
+    file << ",\"ts\":" << event.start << ",\"dur\":" << event.duration << ",\"pid\":1,\"tid\":" << event.thread;
+    file << ",\"args\":{" << event.arguments << "}}";
+  }
+  file << endl << "]}" << endl;
+  file.close();
+  if (!file)
+    throwException(L"Unable to write: " + fileName);
+}
+
+TraceEvent::TraceEvent(const Trace &trace,const wstring &category,const wstring &name)
+  : _trace(trace)
+{
+  if (!_trace.enabled())
+    return;
+
+  _category=category;
+  _name=name;
+  _start=chrono::steady_clock::now();
+}
+
+TraceEvent::~TraceEvent()
+{
+  if (_trace.enabled() && !_name.empty())
+    _trace.add(_category,_name,_start,_arguments);
+}
+
+void TraceEvent::argument(const wstring &name,const size_t value)
+{
+  if (_name.empty())
+    return;
+
+  _arguments+=(_arguments.empty() ? "" : ",") + jsonString(name) + ":" + to_string(value);
+}
+
+void TraceEvent::argument(const wstring &name,const wstring &value)
+{
+  if (_name.empty())
+    return;
+
+  _arguments+=(_arguments.empty() ? "" : ",") + jsonString(name) + ":" + jsonString(value);
+}
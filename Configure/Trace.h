@@ -0,0 +1,76 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __Trace__
+#define __Trace__
+
+#include <map>
+
+class Trace
+{
+public:
+  Trace();
+
+  void add(const wstring &category,const wstring &name,const chrono::steady_clock::time_point &start,const string &arguments) const;
+
+  bool enabled() const;
+  void enabled(bool value);
+
+  size_t eventCount() const;
+
+  void write(const wstring &fileName) const;
+
+private:
+  struct Event
+  {
+    string     arguments;
+    wstring    category;
+    long long  duration;
+    wstring    name;
+    long long  start;
+    size_t     thread;
+  };
+
+  atomic<bool>                       _enabled;
+  mutable vector<Event>              _events;
+  mutable mutex                      _lock;
+  chrono::steady_clock::time_point   _origin;
+  mutable map<thread::id,size_t>     _threads;
+};
+
+class TraceEvent
+{
+public:
+  TraceEvent(const Trace &trace,const wstring &category,const wstring &name);
+
+  ~TraceEvent();
+
+  void argument(const wstring &name,const size_t value);
+
+  void argument(const wstring &name,const wstring &value);
+
+private:
+  string                            _arguments;
+  wstring                           _category;
+  wstring                           _name;
+  chrono::steady_clock::time_point  _start;
+  const Trace                       &_trace;
+};
+
+#endif // __Trace__
@@ -0,0 +1,140 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#include "stdafx.h"
+#include "TrainingProject.h"
+#include "Shared.h"
+
+TrainingProject::TrainingProject(const Options &options)
+  : _options(options)
+{
+}
+
+const wstring TrainingProject::fileName() const
+{
+  return(name() + L".vcxproj");
+}
+
+const wstring TrainingProject::guid() const
+{
+  return(createGuid(name()));
+}
+
+const wstring TrainingProject::name() const
+{
+  return(L"PGO_Training");
+}
+
+void TrainingProject::write(const vector<ProjectFile*> &references,const vector<wstring> &formats,const OutputWriter &outputWriter) const
+{
+  wstringstream
+    project,
+    script;
+
+  wstring
+    projectDir(pathFromRoot(_options.solutionName() + L".Projects\\" + name()));
+
+  filesystem::create_directories(nativePath(projectDir));
+
+  writeProject(project,references);
+  outputWriter.write(projectDir + L"\\" + fileName(),project.str());
+
+  writeScript(script,formats);
+  outputWriter.write(projectDir + L"\\train.cmd",script.str());
+}
+
+void TrainingProject::writeProject(wostream &file,const vector<ProjectFile*> &references) const
+{
+  file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>" << endl;
+  file << "<Project DefaultTargets=\"Build\" ToolsVersion=\"4.0\" xmlns=\"http://schemas.microsoft.com/developer/msbuild/2003\">" << endl;
+  file << "  <ItemGroup Label=\"ProjectConfigurations\">" << endl;
+  file << "    <ProjectConfiguration Include=\"PGInstrument|" << _options.platformName() << "\">" << endl;
+  file << "      <Configuration>PGInstrument</Configuration>" << endl;
+  file << "      <Platform>" << _options.platformName() << "</Platform>" << endl;
+  file << "    </ProjectConfiguration>" << endl;
+  file << "  </ItemGroup>" << endl;
+  file << "  <PropertyGroup Label=\"Globals\">" << endl;
+  file << "    <ProjectName>" << name() << "</ProjectName>" << endl;
+  file << "    <ProjectGuid>{" << guid() << "}</ProjectGuid>" << endl;
+  file << "    <Keyword>MakeFileProj</Keyword>" << endl;
+  file << "  </PropertyGroup>" << endl;
+  file << "  <Import Project=\"$(VCTargetsPath)\\Microsoft.Cpp.Default.props\" />" << endl;
+  file << "  <PropertyGroup Label=\"Configuration\">" << endl;
+  file << "    <ConfigurationType>Makefile</ConfigurationType>" << endl;
+  file << "    <PlatformToolset>" << _options.platformToolset() << "</PlatformToolset>" << endl;
+  file << "  </PropertyGroup>" << endl;
+  file << "  <Import Project=\"$(VCTargetsPath)\\Microsoft.Cpp.props\" />" << endl;
+  file << "  <PropertyGroup>" << endl;
+  file << "    <IntDir>PGO\\" << _options.platformName() << "\\</IntDir>" << endl;
+  file << "    <NMakeBuildCommandLine>call train.cmd</NMakeBuildCommandLine>" << endl;
+  file << "    <NMakeReBuildCommandLine>call train.cmd</NMakeReBuildCommandLine>" << endl;
+  file << "  </PropertyGroup>" << endl;
+  file << "  <ItemGroup>" << endl;
+  file << "    <None Include=\"train.cmd\" />" << endl;
+  file << "  </ItemGroup>" << endl;
+  file << "  <ItemGroup>" << endl;
+  for (auto& reference : references)
+  {
+    file << "    <ProjectReference Include=\"..\\..\\" << reference->projectDirectory() << "\\" << reference->fileName() << "\">" << endl;
+    file << "      <Project>{" << reference->guid() << "}</Project>" << endl;
+    file << "      <ReferenceOutputAssembly>false</ReferenceOutputAssembly>" << endl;
+    file << "    </ProjectReference>" << endl;
+  }
+  file << "  </ItemGroup>" << endl;
+  file << "  <Import Project=\"$(VCTargetsPath)\\Microsoft.Cpp.targets\" />" << endl;
+  file << "</Project>" << endl;
+}
+
+void TrainingProject::writeScript(wostream &file,const vector<wstring> &formats) const
+{
+  wstring
+    magick;
+
+  magick=_options.isImageMagick7() ? L"magick.exe" : L"convert.exe";
+
+  // The script runs from the Makefile project, its PATH contains pgort and pgomgr of the toolset.
+  file << "@echo off" << endl;
+  file << "rem Generated by Configure, do not edit." << endl;
+  file << "rem Runs a decode, resize and encode workload with the PGInstrument binaries and merges the profiles." << endl;
+  file << "setlocal" << endl;
+  // The instrumented binaries of a cross build cannot run on the machine that builds them.
+  if (_options.platform() == Platform::ARM64)
+  {
+    file << "set HOST=%PROCESSOR_ARCHITECTURE%" << endl;
+    file << "if defined PROCESSOR_ARCHITEW6432 set HOST=%PROCESSOR_ARCHITEW6432%" << endl;
+    file << "if /i not \"%HOST%\"==\"ARM64\" (" << endl;
+    file << "  echo error: The ARM64 binaries cannot be trained on this %HOST% machine, run train.cmd on an ARM64 machine." << endl;
+    file << "  exit /b 1" << endl;
+    file << ")" << endl;
+  }
+  file << "cd /d \"%~dp0..\\..\\" << _options.binDirectory(L"PGInstrument") << "\" || exit /b 1" << endl;
+  file << "set TRAINING=%TEMP%\\ImageMagick.PGO" << endl;
+  file << "if exist \"%TRAINING%\" rd /s /q \"%TRAINING%\"" << endl;
+  file << "mkdir \"%TRAINING%\" || exit /b 1" << endl;
+  file << magick << " logo: -resize 200%% \"%TRAINING%\\input.miff\" || exit /b 1" << endl;
+  file << "for %%f in (";
+  for (size_t i=0; i < formats.size(); i++)
+    file << (i == 0 ? L"" : L" ") << formats[i];
+  file << ") do (" << endl;
+  file << "  " << magick << " \"%TRAINING%\\input.miff\" -resize 50%% \"%TRAINING%\\output.%%f\" >nul 2>&1" << endl;
+  file << "  " << magick << " \"%TRAINING%\\output.%%f\" -resize 200%% -unsharp 0x1 null: >nul 2>&1" << endl;
+  file << ")" << endl;
+  file << "for %%f in (*.pgd) do pgomgr /merge \"%%f\" >nul || exit /b 1" << endl;
+  file << "rd /s /q \"%TRAINING%\"" << endl;
+}
@@ -0,0 +1,48 @@
+/*
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%                                                                             %
+%  Copyright 2014-2021 ImageMagick Studio LLC, a non-profit organization      %
+%  dedicated to making software imaging solutions freely available.           %
+%                                                                             %
+%  You may not use this file except in compliance with the License.  You may  %
+%  obtain a copy of the License at                                            %
+%                                                                             %
+%    http://www.imagemagick.org/script/license.php                            %
+%                                                                             %
+%  Unless required by applicable law or agreed to in writing, software        %
+%  distributed under the License is distributed on an "AS IS" BASIS,          %
+%  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   %
+%  See the License for the specific language governing permissions and        %
+%  limitations under the License.                                             %
+%                                                                             %
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*/
+#ifndef __TrainingProject__
+#define __TrainingProject__
+
+#include "Options.h"
+#include "OutputWriter.h"
+#include "ProjectFile.h"
+
+class TrainingProject
+{
+public:
+  TrainingProject(const Options &options);
+
+  const wstring fileName() const;
+
+  const wstring guid() const;
+
+  const wstring name() const;
+
+  void write(const vector<ProjectFile*> &references,const vector<wstring> &formats,const OutputWriter &outputWriter) const;
+
+private:
+  void writeProject(wostream &file,const vector<ProjectFile*> &references) const;
+
+  void writeScript(wostream &file,const vector<wstring> &formats) const;
+
+  const Options &_options;
+};
+
+#endif // __TrainingProject__
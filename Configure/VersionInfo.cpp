@@ -21,7 +21,16 @@
 #include "VersionInfo.h"
 #include "Shared.h"
 
-VersionInfo::VersionInfo()
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#define closePipe _pclose
+#else
+#define closePipe pclose
+#endif
+
+VersionInfo::VersionInfo(const Trace &trace)
+  : _trace(trace)
 {
 }
 
@@ -33,7 +42,16 @@ const wstring VersionInfo::executeCommand(const wstring &command) const
   wstring
     result;
 
+  TraceEvent
+    event(_trace,L"process",L"Run command");
+
+  event.argument(L"command",command);
+
+#ifdef _WIN32
   pipe=_wpopen(command.c_str(), L"rt");
+#else
+  pipe=popen(wstringToString(command).c_str(), "r");
+#endif
   if (pipe == (FILE *) NULL)
     return(L"");
   try
@@ -49,10 +67,10 @@ const wstring VersionInfo::executeCommand(const wstring &command) const
   }
   catch(...)
   {
-    _pclose(pipe);
+    closePipe(pipe);
     return(L"");
   }
-  if (_pclose(pipe) != 0)
+  if (closePipe(pipe) != 0)
     return(L"");
   result=replace(result,L"\n",L"");
   return(result);
@@ -66,12 +84,21 @@ const wstring VersionInfo::getFileModificationDate(const wstring &fileName,const
   struct tm
     tm;
 
+#ifdef _WIN32
   struct _stat64
     attributes;
 
   if (_wstati64(fileName.c_str(),&attributes) != 0)
     return(L"");
   (void) localtime_s(&tm,&attributes.st_mtime);
+#else
+  struct stat
+    attributes;
+
+  if (stat(nativePath(fileName).c_str(),&attributes) != 0)
+    return(L"");
+  (void) localtime_r(&attributes.st_mtime,&tm);
+#endif
   (void) wcsftime(buffer,20,format.c_str(),&tm);
   return(wstring(buffer));
 }
@@ -117,7 +144,10 @@ bool VersionInfo::load()
   wstring
     line;
 
-  version.open(pathFromRoot(L"ImageMagick\\m4\\version.m4"));
+  TraceEvent
+    event(_trace,L"phase",L"Load version information");
+
+  version.open(nativePath(pathFromRoot(L"ImageMagick\\m4\\version.m4")));
   if (!version)
     return(false);
 
@@ -184,16 +214,16 @@ const wstring VersionInfo::releaseDate() const
 
 void VersionInfo::setGitRevision()
 {
-  _gitRevision=executeCommand(L"cd " + pathFromRoot(L"ImageMagick") + L" && git rev-parse --short HEAD");
+  _gitRevision=executeCommand(L"cd " + nativePath(pathFromRoot(L"ImageMagick")).wstring() + L" && git rev-parse --short HEAD");
   if (_gitRevision != L"")
-    _gitRevision+=executeCommand(L"cd " + pathFromRoot(L"ImageMagick") + L" && git log -1 --format=:%cd --date=format:%Y%m%d");
+    _gitRevision+=executeCommand(L"cd " + nativePath(pathFromRoot(L"ImageMagick")).wstring() + L" && git log -1 --format=:%cd --date=format:%Y%m%d");
   if (_gitRevision == L"")
     _gitRevision=getFileModificationDate(pathFromRoot(L"ImageMagick\\m4\\version.m4"),L"%Y%m%d");
 }
 
 void VersionInfo::setReleaseDate()
 {
-  _releaseDate=executeCommand(L"cd " + pathFromRoot(L"ImageMagick") + L" && git log -1 --format=%cd --date=format:%Y-%m-%d");
+  _releaseDate=executeCommand(L"cd " + nativePath(pathFromRoot(L"ImageMagick")).wstring() + L" && git log -1 --format=%cd --date=format:%Y-%m-%d");
   if (_releaseDate == L"")
     _releaseDate=getFileModificationDate(pathFromRoot(L"ImageMagick\\m4\\version.m4"),L"%Y-%m-%d");
 }
@@ -20,11 +20,13 @@
 #ifndef __VersionInfo__
 #define __VersionInfo__
 
+#include "Trace.h"
+
 class VersionInfo
 {
 public:
 
-  VersionInfo();
+  VersionInfo(const Trace &trace);
 
   const wstring fullVersion() const;
 
@@ -78,6 +80,7 @@ private:
   wstring _ppLibraryRevision;
   wstring _ppLibraryAge;
   wstring _releaseDate;
+  const Trace &_trace;
 };
 
 #endif // __VersionInfo__
@@ -20,9 +20,10 @@
 #ifndef __WaitDialog__
 #define __WaitDialog__
 
+#include "Progress.h"
 #include "resource.h"
 
-class WaitDialog : public CDialog
+class WaitDialog : public CDialog, public Progress
 {
 public:
 
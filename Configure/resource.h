@@ -33,6 +33,7 @@
 #define IDD_WAITDIALOG                  1019
 #define IDC_MSGCTRL                     1020
 #define IDC_PROGRESSCTRL                1021
+#define IDC_INSTRUCTION_SET             1022
 
 // Next default values for new objects
 // 
@@ -10,6 +10,8 @@
 #pragma once
 #endif // _MSC_VER > 1000
 
+// ConfigureCore and ConfigureCLI are compiled without MFC
+#ifndef CONFIGURE_NO_MFC
 #define WINVER 0x0501
 
 #define VC_EXTRALEAN // Exclude rarely-used stuff from Windows headers
@@ -22,12 +24,19 @@
 #endif // _AFX_NO_AFXCMN_SUPPORT
 
 #include "resource.h" // main symbols
+#endif // CONFIGURE_NO_MFC
 
+#include <cstring>
+#include <cwctype>
 #include <string>
 #include <vector>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
 using namespace std;
 
 //#pragma warning(disable : 4786)
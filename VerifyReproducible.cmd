@@ -0,0 +1,80 @@
+@echo off
+setlocal enabledelayedexpansion
+
+rem Builds a solution that was configured with /reproducible from two different root folders and compares the outputs.
+rem The second build uses a drive letter that is mapped to the same folder with subst, so every absolute path differs.
+
+set SOLUTION=%~nx1
+if "%SOLUTION%"=="" goto USAGE
+
+set PLATFORM=x64
+if not "%2"=="" set PLATFORM=%2
+
+set ROOT=%~dp0
+set ROOT=%ROOT:~0,-1%
+set FIRST=%TEMP%\VerifyReproducible\first
+set SECOND=%TEMP%\VerifyReproducible\second
+
+if not exist "%ROOT%\%SOLUTION%" (
+  echo Unable to find %SOLUTION% in %ROOT%
+  exit /b 1
+)
+
+set DRIVE=
+for %%d in (R S T U V W X Y Z) do (
+  if "!DRIVE!"=="" if not exist %%d:\ set DRIVE=%%d:
+)
+if "%DRIVE%"=="" (
+  echo Unable to find a free drive letter for the second build
+  exit /b 1
+)
+
+call :BUILD "%ROOT%" "%FIRST%"
+if errorlevel 1 exit /b 1
+
+subst %DRIVE% "%ROOT%"
+if errorlevel 1 exit /b 1
+call :BUILD %DRIVE% "%SECOND%"
+set RESULT=%ERRORLEVEL%
+subst %DRIVE% /d
+if not %RESULT%==0 exit /b 1
+
+set DIFFERENCES=0
+for /R "%FIRST%" %%f in (*) do (
+  set FILE=%%f
+  set FILE=!FILE:%FIRST%=%SECOND%!
+  fc /b "%%f" "!FILE!" > nul 2>&1
+  if errorlevel 1 (
+    echo Different: !FILE:%SECOND%\=!
+    set /a DIFFERENCES+=1
+  )
+)
+for /R "%SECOND%" %%f in (*) do (
+  set FILE=%%f
+  set FILE=!FILE:%SECOND%=%FIRST%!
+  if not exist "!FILE!" (
+    echo Only in the second build: !FILE:%FIRST%\=!
+    set /a DIFFERENCES+=1
+  )
+)
+
+if not %DIFFERENCES%==0 (
+  echo %DIFFERENCES% files are different
+  exit /b 1
+)
+
+echo The outputs of both builds are identical
+exit /b 0
+
+:BUILD
+if exist "%~2" rmdir /s /q "%~2"
+msbuild "%~1\%SOLUTION%" /m /t:Rebuild /p:Configuration=Release,Platform=%PLATFORM%
+if errorlevel 1 exit /b 1
+rem The object files in the projects folders are compared as well, the linker can hide differences between them.
+robocopy "%~1\." "%~2" *.obj *.lib *.dll *.exe /s /xd .git Configure > nul
+exit /b 0
+
+:USAGE
+echo Usage: VerifyReproducible.cmd ^<solution^> [platform]
+echo The solution should be in the same folder as this script.
+exit /b 1